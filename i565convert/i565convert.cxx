@@ -0,0 +1,158 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include <getopt.h>
+
+#include "imageDecoder.h"
+#include "mappedImage565.h"
+#include "rle565.h"
+
+//-------------------------------------------------------------------------
+
+using namespace raspifb16;
+
+//-------------------------------------------------------------------------
+
+void
+printUsage(
+    std::ostream& os,
+    const std::string& name)
+{
+    os << "\n";
+    os << "Usage: " << name << " <options> <input> <output.i565>\n";
+    os << "\n";
+    os << "Convert a PPM, PGM, QOI or PNG image to a .i565 file.\n";
+    os << "\n";
+    os << "    --auto,-a - run length encode if it is smaller\n";
+    os << "    --dither,-d - ordered dither when reducing to RGB565\n";
+    os << "    --help,-h - print usage and exit\n";
+    os << "    --rle,-r - run length encode the pixels\n";
+    os << "\n";
+}
+
+//-------------------------------------------------------------------------
+
+int
+main(
+    int argc,
+    char *argv[])
+{
+    Dither dither{Dither::NONE};
+    bool rle{false};
+    bool automatic{false};
+
+    static const char* sopts = "adhr";
+    static struct option lopts[] = 
+    {
+        { "auto", no_argument, nullptr, 'a' },
+        { "dither", no_argument, nullptr, 'd' },
+        { "help", no_argument, nullptr, 'h' },
+        { "rle", no_argument, nullptr, 'r' },
+        { nullptr, no_argument, nullptr, 0 }
+    };
+
+    int opt = 0;
+
+    while ((opt = ::getopt_long(argc, argv, sopts, lopts, nullptr)) != -1)
+    {
+        switch (opt)
+        {
+        case 'a':
+
+            automatic = true;
+
+            break;
+
+        case 'd':
+
+            dither = Dither::ORDERED;
+
+            break;
+
+        case 'h':
+
+            printUsage(std::cout, argv[0]);
+            ::exit(EXIT_SUCCESS);
+
+            break;
+
+        case 'r':
+
+            rle = true;
+
+            break;
+
+        default:
+
+            printUsage(std::cerr, argv[0]);
+            ::exit(EXIT_FAILURE);
+
+            break;
+        }
+    }
+
+    if ((argc - optind) != 2)
+    {
+        printUsage(std::cerr, argv[0]);
+        ::exit(EXIT_FAILURE);
+    }
+
+    const std::string input{argv[optind]};
+    const std::string output{argv[optind + 1]};
+
+    try
+    {
+        auto image = loadImage(input, dither);
+
+        if (automatic)
+        {
+            const size_t raw = image.getWidth() *
+                               image.getHeight() *
+                               sizeof(uint16_t);
+
+            rle = Rle565{image}.getEncodedSize() < raw;
+        }
+
+        auto encoding = (rle)
+                      ? MappedImage565::Encoding::RLE
+                      : MappedImage565::Encoding::RAW;
+
+        MappedImage565::write(output, image, encoding);
+    }
+    catch (std::exception& error)
+    {
+        std::cerr << "Error: " << error.what() << "\n";
+        exit(EXIT_FAILURE);
+    }
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef ALIGNED_ALLOCATOR_H
+#define ALIGNED_ALLOCATOR_H
+
+//-------------------------------------------------------------------------
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include <stdlib.h>
+
+//-------------------------------------------------------------------------
+
+namespace raspifb16
+{
+
+//-------------------------------------------------------------------------
+
+// The number of buffers allocated by any AlignedAllocator (so of every
+// Image565 pixel buffer), for checking that steady state drawing does not
+// allocate new pixel buffers. Other heap use is not counted.
+
+inline std::atomic<uint64_t>&
+pixelBufferAllocationCount()
+{
+    static std::atomic<uint64_t> count{0};
+    return count;
+}
+
+//-------------------------------------------------------------------------
+
+// A standard allocator for containers whose storage must start on an
+// Alignment byte boundary (C++14 operator new only guarantees alignment
+// for fundamental types).
+
+template<typename T, size_t Alignment>
+class AlignedAllocator
+{
+public:
+
+    using value_type = T;
+
+    template<typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() = default;
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&)
+    {
+    }
+
+    T*
+    allocate(
+        size_t n)
+    {
+        void* p{nullptr};
+
+        if (::posix_memalign(&p, Alignment, n * sizeof(T)) != 0)
+        {
+            throw std::bad_alloc();
+        }
+
+        pixelBufferAllocationCount().fetch_add(1, std::memory_order_relaxed);
+
+        return static_cast<T*>(p);
+    }
+
+    void
+    deallocate(
+        T* p,
+        size_t)
+    {
+        ::free(p);
+    }
+};
+
+//-------------------------------------------------------------------------
+
+template<typename T, typename U, size_t Alignment>
+bool
+operator==(
+    const AlignedAllocator<T, Alignment>&,
+    const AlignedAllocator<U, Alignment>&)
+{
+    return true;
+}
+
+template<typename T, typename U, size_t Alignment>
+bool
+operator!=(
+    const AlignedAllocator<T, Alignment>&,
+    const AlignedAllocator<U, Alignment>&)
+{
+    return false;
+}
+
+//-------------------------------------------------------------------------
+
+} // namespace raspifb16
+
+//-------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,264 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#include <cstring>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "blend565.h"
+
+//-------------------------------------------------------------------------
+
+namespace
+{
+
+//-------------------------------------------------------------------------
+
+// Skip eight alpha values at a time while they all equal value.
+
+int32_t
+matchRun(
+    const uint8_t* alpha,
+    int32_t length,
+    uint8_t value)
+{
+    const uint64_t pattern = UINT64_C(0x0101010101010101) * value;
+
+    int32_t i = 0;
+
+    for ( ; (i + 8) <= length ; i += 8)
+    {
+        uint64_t word;
+        memcpy(&word, alpha + i, sizeof(word));
+
+        if (word != pattern)
+        {
+            break;
+        }
+    }
+
+    while ((i < length) && (alpha[i] == value))
+    {
+        ++i;
+    }
+
+    return i;
+}
+
+//-------------------------------------------------------------------------
+
+} // namespace
+
+//-------------------------------------------------------------------------
+
+raspifb16::AlphaRun
+raspifb16::alphaRun(
+    const uint8_t* alpha,
+    int32_t length,
+    int32_t& runLength)
+{
+    if (alpha[0] == 0)
+    {
+        runLength = matchRun(alpha, length, 0);
+        return AlphaRun::TRANSPARENT;
+    }
+
+    if (alpha[0] == 0xFF)
+    {
+        runLength = matchRun(alpha, length, 0xFF);
+        return AlphaRun::OPAQUE;
+    }
+
+    runLength = 1;
+
+    while ((runLength < length) &&
+           (alpha[runLength] != 0) &&
+           (alpha[runLength] != 0xFF))
+    {
+        ++runLength;
+    }
+
+    return AlphaRun::TRANSLUCENT;
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::blendRow(
+    uint16_t* dst,
+    const uint16_t* src,
+    const uint8_t* alpha,
+    int32_t length)
+{
+    int32_t i = 0;
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+    const uint16x8_t mask6 = vdupq_n_u16(0x3F);
+    const uint16x8_t mask5 = vdupq_n_u16(0x1F);
+
+    auto channel = [](int16x8_t cd, int16x8_t cs, int16x8_t w) -> int16x8_t
+    {
+        int16x8_t delta = vmulq_s16(vsubq_s16(cs, cd), w);
+        return vaddq_s16(cd, vshrq_n_s16(delta, 5));
+    };
+
+    for ( ; (i + 8) <= length ; i += 8)
+    {
+        uint8x8_t a = vld1_u8(alpha + i);
+        uint64_t bits = vget_lane_u64(vreinterpret_u64_u8(a), 0);
+
+        if (bits == 0)
+        {
+            continue;
+        }
+
+        if (bits == UINT64_MAX)
+        {
+            vst1q_u16(dst + i, vld1q_u16(src + i));
+            continue;
+        }
+
+        int16x8_t w = vreinterpretq_s16_u16(
+            vshrq_n_u16(vaddq_u16(vmovl_u8(a), vdupq_n_u16(4)), 3));
+
+        uint16x8_t pd = vld1q_u16(dst + i);
+        uint16x8_t ps = vld1q_u16(src + i);
+
+        int16x8_t rd = vreinterpretq_s16_u16(vshrq_n_u16(pd, 11));
+        int16x8_t rs = vreinterpretq_s16_u16(vshrq_n_u16(ps, 11));
+        int16x8_t gd = vreinterpretq_s16_u16(
+            vandq_u16(vshrq_n_u16(pd, 5), mask6));
+        int16x8_t gs = vreinterpretq_s16_u16(
+            vandq_u16(vshrq_n_u16(ps, 5), mask6));
+        int16x8_t bd = vreinterpretq_s16_u16(vandq_u16(pd, mask5));
+        int16x8_t bs = vreinterpretq_s16_u16(vandq_u16(ps, mask5));
+
+        uint16x8_t red = vreinterpretq_u16_s16(channel(rd, rs, w));
+        uint16x8_t green = vreinterpretq_u16_s16(channel(gd, gs, w));
+        uint16x8_t blue = vreinterpretq_u16_s16(channel(bd, bs, w));
+
+        uint16x8_t rgb = vorrq_u16(vorrq_u16(vshlq_n_u16(red, 11),
+                                             vshlq_n_u16(green, 5)),
+                                   blue);
+
+        vst1q_u16(dst + i, rgb);
+    }
+
+#elif defined(__SSE2__)
+
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i four = _mm_set1_epi16(4);
+    const __m128i mask6 = _mm_set1_epi16(0x3F);
+    const __m128i mask5 = _mm_set1_epi16(0x1F);
+
+    auto channel = [](__m128i cd, __m128i cs, __m128i w) -> __m128i
+    {
+        __m128i delta = _mm_mullo_epi16(_mm_sub_epi16(cs, cd), w);
+        return _mm_add_epi16(cd, _mm_srai_epi16(delta, 5));
+    };
+
+    for ( ; (i + 8) <= length ; i += 8)
+    {
+        uint64_t bits;
+        memcpy(&bits, alpha + i, sizeof(bits));
+
+        if (bits == 0)
+        {
+            continue;
+        }
+
+        auto d = reinterpret_cast<__m128i*>(dst + i);
+        auto s = reinterpret_cast<const __m128i*>(src + i);
+
+        if (bits == UINT64_MAX)
+        {
+            _mm_storeu_si128(d, _mm_loadu_si128(s));
+            continue;
+        }
+
+        __m128i a = _mm_unpacklo_epi8(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(alpha + i)),
+            zero);
+        __m128i w = _mm_srli_epi16(_mm_add_epi16(a, four), 3);
+
+        __m128i pd = _mm_loadu_si128(d);
+        __m128i ps = _mm_loadu_si128(s);
+
+        __m128i red = channel(_mm_srli_epi16(pd, 11),
+                              _mm_srli_epi16(ps, 11),
+                              w);
+        __m128i green = channel(_mm_and_si128(_mm_srli_epi16(pd, 5), mask6),
+                                _mm_and_si128(_mm_srli_epi16(ps, 5), mask6),
+                                w);
+        __m128i blue = channel(_mm_and_si128(pd, mask5),
+                               _mm_and_si128(ps, mask5),
+                               w);
+
+        __m128i rgb = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(red, 11),
+                                                _mm_slli_epi16(green, 5)),
+                                   blue);
+
+        _mm_storeu_si128(d, rgb);
+    }
+
+#endif
+
+    while (i < length)
+    {
+        int32_t run = 0;
+
+        switch (alphaRun(alpha + i, length - i, run))
+        {
+        case AlphaRun::TRANSPARENT:
+
+            break;
+
+        case AlphaRun::OPAQUE:
+
+            memcpy(dst + i, src + i, run * sizeof(uint16_t));
+
+            break;
+
+        case AlphaRun::TRANSLUCENT:
+
+            for (int32_t j = i ; j < (i + run) ; ++j)
+            {
+                dst[j] = lerp565(dst[j], src[j], alphaWeight(alpha[j]));
+            }
+
+            break;
+        }
+
+        i += run;
+    }
+}
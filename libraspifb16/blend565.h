@@ -0,0 +1,115 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef BLEND565_H
+#define BLEND565_H
+
+//-------------------------------------------------------------------------
+
+#include <cstdint>
+
+//-------------------------------------------------------------------------
+
+namespace raspifb16
+{
+
+//-------------------------------------------------------------------------
+
+// Spread the fields of an RGB565 pixel out in a 32 bit word (green in the
+// top half, red and blue in the bottom) leaving room for each to be
+// multiplied by up to 32 without overflowing into its neighbour.
+
+constexpr uint32_t spreadMask565{0x07E0F81F};
+
+inline uint32_t
+spread565(
+    uint16_t rgb)
+{
+    return (rgb | (static_cast<uint32_t>(rgb) << 16)) & spreadMask565;
+}
+
+inline uint16_t
+unspread565(
+    uint32_t rgb)
+{
+    rgb &= spreadMask565;
+
+    return static_cast<uint16_t>(rgb | (rgb >> 16));
+}
+
+// a + (b - a) * weight / 32, for weight in the range 0 to 32.
+
+inline uint16_t
+lerp565(
+    uint16_t a,
+    uint16_t b,
+    uint32_t weight)
+{
+    return unspread565(((spread565(a) * (32 - weight))
+                       + (spread565(b) * weight)) >> 5);
+}
+
+// Reduce an 8 bit alpha to the 0 to 32 weight used by lerp565().
+
+inline uint32_t
+alphaWeight(
+    uint8_t alpha)
+{
+    return (alpha + 4) >> 3;
+}
+
+//-------------------------------------------------------------------------
+
+enum class AlphaRun { TRANSPARENT, OPAQUE, TRANSLUCENT };
+
+// Classify the run of pixels at the start of alpha and return its length.
+// A translucent run ends at the first fully transparent or fully opaque
+// pixel.
+
+AlphaRun
+alphaRun(
+    const uint8_t* alpha,
+    int32_t length,
+    int32_t& runLength);
+
+// Blend length pixels of src over dst using the alpha values.
+
+void
+blendRow(
+    uint16_t* dst,
+    const uint16_t* src,
+    const uint8_t* alpha,
+    int32_t length);
+
+//-------------------------------------------------------------------------
+
+} // namespace raspifb16
+
+//-------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,219 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+#include "blit565.h"
+
+//-------------------------------------------------------------------------
+
+bool
+raspifb16::clipBlit(
+    BlitRegion& region,
+    int32_t srcWidth,
+    int32_t srcHeight,
+    int32_t dstWidth,
+    int32_t dstHeight)
+{
+    // Trim the left and top against both ends, moving the other end by
+    // the same amount.
+
+    int32_t left = std::max(std::max(-region.m_srcX, -region.m_dstX), 0);
+    int32_t top = std::max(std::max(-region.m_srcY, -region.m_dstY), 0);
+
+    region.m_srcX += left;
+    region.m_dstX += left;
+    region.m_width -= left;
+
+    region.m_srcY += top;
+    region.m_dstY += top;
+    region.m_height -= top;
+
+    region.m_width = std::min(region.m_width,
+                              std::min(srcWidth - region.m_srcX,
+                                       dstWidth - region.m_dstX));
+
+    region.m_height = std::min(region.m_height,
+                               std::min(srcHeight - region.m_srcY,
+                                        dstHeight - region.m_dstY));
+
+    return (region.m_width > 0) && (region.m_height > 0);
+}
+
+//-------------------------------------------------------------------------
+
+bool
+raspifb16::blit(
+    const Image565& src,
+    const Image565Rectangle& rectangle,
+    Image565& dst,
+    const Image565Point& p)
+{
+    BlitRegion region{rectangle.x(),
+                      rectangle.y(),
+                      p.x(),
+                      p.y(),
+                      rectangle.width(),
+                      rectangle.height()};
+
+    if (!clipBlit(region,
+                  src.getWidth(),
+                  src.getHeight(),
+                  dst.getWidth(),
+                  dst.getHeight()))
+    {
+        return false;
+    }
+
+    // When copying down within the same image, copy the rows bottom up so
+    // that none are overwritten before they are read.
+
+    bool bottomUp = (&src == &dst) && (region.m_dstY > region.m_srcY);
+
+    for (int32_t i = 0 ; i < region.m_height ; ++i)
+    {
+        int32_t j = (bottomUp) ? (region.m_height - 1 - i) : i;
+
+        memmove(dst.getRow(region.m_dstY + j) + region.m_dstX,
+                src.getRow(region.m_srcY + j) + region.m_srcX,
+                region.m_width * sizeof(uint16_t));
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------
+
+bool
+raspifb16::blit(
+    const Image565& src,
+    const Image565Rectangle& rectangle,
+    Image565View dst,
+    const Image565Point& p)
+{
+    BlitRegion region{rectangle.x(),
+                      rectangle.y(),
+                      p.x(),
+                      p.y(),
+                      rectangle.width(),
+                      rectangle.height()};
+
+    if (!clipBlit(region,
+                  src.getWidth(),
+                  src.getHeight(),
+                  dst.getWidth(),
+                  dst.getHeight()))
+    {
+        return false;
+    }
+
+    auto srcFirst = src.getRow(region.m_srcY) + region.m_srcX;
+    auto dstFirst = dst.getRow(region.m_dstY) + region.m_dstX;
+
+    // The view may be of src, so copy bottom up if the destination comes
+    // later in memory.
+
+    bool bottomUp = std::less<const uint16_t*>()(srcFirst, dstFirst);
+
+    for (int32_t i = 0 ; i < region.m_height ; ++i)
+    {
+        int32_t j = (bottomUp) ? (region.m_height - 1 - i) : i;
+
+        memmove(dst.getRow(region.m_dstY + j) + region.m_dstX,
+                src.getRow(region.m_srcY + j) + region.m_srcX,
+                region.m_width * sizeof(uint16_t));
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------
+
+bool
+raspifb16::blit(
+    const Image565& src,
+    const Image565Rectangle& rectangle,
+    const FrameBuffer565& dst,
+    const FB565Point& p)
+{
+    return dst.putImage(p, src, rectangle);
+}
+
+//-------------------------------------------------------------------------
+
+bool
+raspifb16::blit(
+    const FrameBuffer565& src,
+    const FB565Rectangle& rectangle,
+    Image565& dst,
+    const Image565Point& p)
+{
+    return src.getImage(rectangle, dst, p);
+}
+
+//-------------------------------------------------------------------------
+
+bool
+raspifb16::blit(
+    const FrameBuffer565& src,
+    const FB565Rectangle& rectangle,
+    const FrameBuffer565& dst,
+    const FB565Point& p)
+{
+    BlitRegion region{rectangle.x(),
+                      rectangle.y(),
+                      p.x(),
+                      p.y(),
+                      rectangle.width(),
+                      rectangle.height()};
+
+    if (!clipBlit(region,
+                  src.getWidth(),
+                  src.getHeight(),
+                  dst.getWidth(),
+                  dst.getHeight()))
+    {
+        return false;
+    }
+
+    // Reading the whole region before writing any of it also takes care
+    // of overlapping copies within one framebuffer.
+
+    Image565 image(region.m_width, region.m_height);
+
+    src.getImage(FB565Rectangle(region.m_srcX,
+                                region.m_srcY,
+                                region.m_width,
+                                region.m_height),
+                 image,
+                 Image565Point(0, 0));
+
+    return dst.putImage(FB565Point(region.m_dstX, region.m_dstY), image);
+}
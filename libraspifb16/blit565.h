@@ -0,0 +1,121 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef BLIT565_H
+#define BLIT565_H
+
+//-------------------------------------------------------------------------
+
+#include <cstdint>
+
+#include "framebuffer565.h"
+#include "image565.h"
+#include "image565View.h"
+
+//-------------------------------------------------------------------------
+
+namespace raspifb16
+{
+
+//-------------------------------------------------------------------------
+
+// A copy of a width x height region from (m_srcX, m_srcY) in the source
+// to (m_dstX, m_dstY) in the destination.
+
+struct BlitRegion
+{
+    int32_t m_srcX;
+    int32_t m_srcY;
+    int32_t m_dstX;
+    int32_t m_dstY;
+    int32_t m_width;
+    int32_t m_height;
+};
+
+// Shrink the region to the part that lies within both the source and
+// the destination. Returns false if there is nothing left to copy.
+
+bool
+clipBlit(
+    BlitRegion& region,
+    int32_t srcWidth,
+    int32_t srcHeight,
+    int32_t dstWidth,
+    int32_t dstHeight);
+
+//-------------------------------------------------------------------------
+
+// Copy rectangle from src to dst with its top left corner at p. Each
+// copy is clipped once and then done a row at a time. Source and
+// destination may be the same, and may overlap.
+
+bool
+blit(
+    const Image565& src,
+    const Image565Rectangle& rectangle,
+    Image565& dst,
+    const Image565Point& p);
+
+// A view may be of the source image itself, as long as it has the same
+// stride.
+
+bool
+blit(
+    const Image565& src,
+    const Image565Rectangle& rectangle,
+    Image565View dst,
+    const Image565Point& p);
+
+bool
+blit(
+    const Image565& src,
+    const Image565Rectangle& rectangle,
+    const FrameBuffer565& dst,
+    const FB565Point& p);
+
+bool
+blit(
+    const FrameBuffer565& src,
+    const FB565Rectangle& rectangle,
+    Image565& dst,
+    const Image565Point& p);
+
+bool
+blit(
+    const FrameBuffer565& src,
+    const FB565Rectangle& rectangle,
+    const FrameBuffer565& dst,
+    const FB565Point& p);
+
+//-------------------------------------------------------------------------
+
+} // namespace raspifb16
+
+//-------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,138 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#include <algorithm>
+
+#include "callStatistics.h"
+
+//-------------------------------------------------------------------------
+
+constexpr size_t raspifb16::CallStatistics::sc_buckets;
+
+//-------------------------------------------------------------------------
+
+std::chrono::nanoseconds
+raspifb16::CallStatistics:: percentile(
+    double fraction) const
+{
+    uint64_t target = static_cast<uint64_t>(fraction * m_calls);
+    uint64_t total{0};
+
+    for (size_t bucket = 0 ; bucket < sc_buckets ; ++bucket)
+    {
+        total += m_histogram[bucket];
+
+        if ((total > 0) && (total >= target))
+        {
+            return std::chrono::nanoseconds(int64_t{2} << bucket);
+        }
+    }
+
+    return std::chrono::nanoseconds::zero();
+}
+
+//-------------------------------------------------------------------------
+
+#ifdef RASPIFB16_STATISTICS
+
+//-------------------------------------------------------------------------
+
+raspifb16::CallCounter:: CallCounter()
+:
+    m_calls{0},
+    m_pixels{0},
+    m_bytes{0},
+    m_totalTime{0},
+    m_histogram()
+{
+    reset();
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::CallCounter:: record(
+    std::chrono::nanoseconds elapsed,
+    uint64_t pixels,
+    uint64_t bytes)
+{
+    constexpr auto relaxed = std::memory_order_relaxed;
+
+    auto ns = static_cast<uint64_t>(std::max(elapsed.count(), int64_t{1}));
+    size_t bucket = 63 - __builtin_clzll(ns);
+    bucket = std::min(bucket, CallStatistics::sc_buckets - 1);
+
+    m_calls.fetch_add(1, relaxed);
+    m_pixels.fetch_add(pixels, relaxed);
+    m_bytes.fetch_add(bytes, relaxed);
+    m_totalTime.fetch_add(elapsed.count(), relaxed);
+    m_histogram[bucket].fetch_add(1, relaxed);
+}
+
+//-------------------------------------------------------------------------
+
+raspifb16::CallStatistics
+raspifb16::CallCounter:: snapshot() const
+{
+    constexpr auto relaxed = std::memory_order_relaxed;
+
+    CallStatistics statistics;
+
+    statistics.m_calls = m_calls.load(relaxed);
+    statistics.m_pixels = m_pixels.load(relaxed);
+    statistics.m_bytes = m_bytes.load(relaxed);
+    statistics.m_totalTime =
+        std::chrono::nanoseconds(m_totalTime.load(relaxed));
+
+    for (size_t bucket = 0 ; bucket < CallStatistics::sc_buckets ; ++bucket)
+    {
+        statistics.m_histogram[bucket] = m_histogram[bucket].load(relaxed);
+    }
+
+    return statistics;
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::CallCounter:: reset()
+{
+    m_calls = 0;
+    m_pixels = 0;
+    m_bytes = 0;
+    m_totalTime = 0;
+
+    for (auto& count : m_histogram)
+    {
+        count = 0;
+    }
+}
+
+//-------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,186 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef CALL_STATISTICS_H
+#define CALL_STATISTICS_H
+
+//-------------------------------------------------------------------------
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+#ifdef RASPIFB16_STATISTICS
+#include <atomic>
+#endif
+
+//-------------------------------------------------------------------------
+
+namespace raspifb16
+{
+
+//-------------------------------------------------------------------------
+
+// Counters for one kind of call. Latencies are kept in a histogram with
+// power of two buckets: bucket n holds calls that took at least 2^n and
+// less than 2^(n + 1) nanoseconds. Anything quicker than 2ns is in the
+// first bucket and anything slower than about two seconds in the last.
+
+struct CallStatistics
+{
+    static constexpr size_t sc_buckets{32};
+
+    uint64_t m_calls;
+    uint64_t m_pixels;
+    uint64_t m_bytes;
+    std::chrono::nanoseconds m_totalTime;
+    std::array<uint64_t, sc_buckets> m_histogram;
+
+    // An upper bound on the latency of the given fraction of calls,
+    // taken from the end of the histogram bucket it falls in.
+
+    std::chrono::nanoseconds percentile(double fraction) const;
+};
+
+//-------------------------------------------------------------------------
+
+// The counters are only compiled in when RASPIFB16_STATISTICS is defined
+// (by building with -DRASPIFB16_STATISTICS=ON). Otherwise CallCounter and
+// CallTimer are empty and every call on them is an inline no-op. The
+// library and the code using it must be built with the same setting.
+
+#ifdef RASPIFB16_STATISTICS
+
+constexpr bool callStatisticsEnabled{true};
+
+// Accumulates CallStatistics. Calls may be recorded on one thread while
+// a snapshot is taken on another.
+
+class CallCounter
+{
+public:
+
+    CallCounter();
+
+    CallCounter(const CallCounter&) = delete;
+    CallCounter& operator=(const CallCounter&) = delete;
+
+    void
+    record(
+        std::chrono::nanoseconds elapsed,
+        uint64_t pixels,
+        uint64_t bytes);
+
+    CallStatistics snapshot() const;
+    void reset();
+
+private:
+
+    std::atomic<uint64_t> m_calls;
+    std::atomic<uint64_t> m_pixels;
+    std::atomic<uint64_t> m_bytes;
+    std::atomic<int64_t> m_totalTime;
+    std::array<std::atomic<uint64_t>, CallStatistics::sc_buckets>
+        m_histogram;
+};
+
+//-------------------------------------------------------------------------
+
+// Times from construction to destruction and records the call in the
+// counter, along with whatever pixels and bytes were counted.
+
+class CallTimer
+{
+public:
+
+    explicit CallTimer(CallCounter& counter)
+    :
+        m_counter(counter),
+        m_start{std::chrono::steady_clock::now()},
+        m_pixels{0},
+        m_bytes{0}
+    {
+    }
+
+    ~CallTimer()
+    {
+        m_counter.record(std::chrono::steady_clock::now() - m_start,
+                         m_pixels,
+                         m_bytes);
+    }
+
+    CallTimer(const CallTimer&) = delete;
+    CallTimer& operator=(const CallTimer&) = delete;
+
+    void
+    count(
+        uint64_t pixels,
+        uint64_t bytes)
+    {
+        m_pixels += pixels;
+        m_bytes += bytes;
+    }
+
+private:
+
+    CallCounter& m_counter;
+    std::chrono::steady_clock::time_point m_start;
+    uint64_t m_pixels;
+    uint64_t m_bytes;
+};
+
+#else
+
+constexpr bool callStatisticsEnabled{false};
+
+class CallCounter
+{
+public:
+
+    void record(std::chrono::nanoseconds, uint64_t, uint64_t) {}
+    CallStatistics snapshot() const { return CallStatistics{}; }
+    void reset() {}
+};
+
+class CallTimer
+{
+public:
+
+    explicit CallTimer(CallCounter&) {}
+    void count(uint64_t, uint64_t) {}
+};
+
+#endif
+
+//-------------------------------------------------------------------------
+
+} // namespace raspifb16
+
+//-------------------------------------------------------------------------
+
+#endif
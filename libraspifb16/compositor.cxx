@@ -0,0 +1,185 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#include "blit565.h"
+#include "compositor.h"
+
+//-------------------------------------------------------------------------
+
+size_t
+raspifb16::Compositor:: addLayer(
+    const Image565& image,
+    const Image565Point& p)
+{
+    m_layers.push_back(Layer{&image, nullptr, nullptr, p, true});
+
+    return m_layers.size() - 1;
+}
+
+//-------------------------------------------------------------------------
+
+size_t
+raspifb16::Compositor:: addLayer(
+    const Image565Alpha& image,
+    const Image565Point& p)
+{
+    m_layers.push_back(Layer{nullptr, &image, nullptr, p, true});
+
+    return m_layers.size() - 1;
+}
+
+//-------------------------------------------------------------------------
+
+size_t
+raspifb16::Compositor:: addLayer(
+    const Sprite565& sprite,
+    const Image565Point& p)
+{
+    m_layers.push_back(Layer{nullptr, nullptr, &sprite, p, true});
+
+    return m_layers.size() - 1;
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::Compositor:: setPosition(
+    size_t layer,
+    const Image565Point& p)
+{
+    if (layer < m_layers.size())
+    {
+        m_layers[layer].m_position = p;
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::Compositor:: setVisible(
+    size_t layer,
+    bool visible)
+{
+    if (layer < m_layers.size())
+    {
+        m_layers[layer].m_visible = visible;
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::Compositor:: compose(
+    Image565View destination) const
+{
+    compose(destination,
+            Image565Rectangle(0,
+                              0,
+                              destination.getWidth(),
+                              destination.getHeight()));
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::Compositor:: compose(
+    Image565View destination,
+    const Image565Rectangle& clip) const
+{
+    auto area = clip.intersection(
+        Image565Rectangle(0,
+                          0,
+                          destination.getWidth(),
+                          destination.getHeight()));
+
+    if (area.empty() || m_layers.empty())
+    {
+        return;
+    }
+
+    Image565View target{destination, area};
+
+    // Start from the top most opaque layer that hides everything below.
+
+    size_t first = m_layers.size();
+
+    while (first > 0)
+    {
+        const auto& layer = m_layers[first - 1];
+
+        if (layer.m_visible && (layer.m_opaque != nullptr))
+        {
+            Image565Rectangle bounds{layer.m_position,
+                                     layer.m_opaque->getWidth(),
+                                     layer.m_opaque->getHeight()};
+
+            auto covered = bounds.intersection(area);
+
+            if ((covered.width() == area.width()) &&
+                (covered.height() == area.height()))
+            {
+                break;
+            }
+        }
+
+        --first;
+    }
+
+    first = (first > 0) ? first - 1 : 0;
+
+    for (size_t i = first ; i < m_layers.size() ; ++i)
+    {
+        const auto& layer = m_layers[i];
+
+        if (!layer.m_visible)
+        {
+            continue;
+        }
+
+        Image565Point p(layer.m_position.x() - area.x(),
+                        layer.m_position.y() - area.y());
+
+        if (layer.m_opaque != nullptr)
+        {
+            blit(*layer.m_opaque,
+                 Image565Rectangle(0,
+                                   0,
+                                   layer.m_opaque->getWidth(),
+                                   layer.m_opaque->getHeight()),
+                 target,
+                 p);
+        }
+        else if (layer.m_alpha != nullptr)
+        {
+            blendImage(target, p, *layer.m_alpha);
+        }
+        else if (layer.m_sprite != nullptr)
+        {
+            putSprite(target, p, *layer.m_sprite);
+        }
+    }
+}
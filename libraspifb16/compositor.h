@@ -0,0 +1,107 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef COMPOSITOR_H
+#define COMPOSITOR_H
+
+//-------------------------------------------------------------------------
+
+#include <cstddef>
+#include <vector>
+
+#include "image565.h"
+#include "image565Alpha.h"
+#include "image565View.h"
+#include "point.h"
+#include "rectangle.h"
+#include "sprite565.h"
+
+//-------------------------------------------------------------------------
+
+namespace raspifb16
+{
+
+//-------------------------------------------------------------------------
+
+// Flattens a stack of layers into one image, so that overlapping panels,
+// shared backgrounds and widgets can be drawn with a single present. The
+// first layer added is at the bottom.
+//
+// Each layer is an opaque image (copied a row at a time), an image with
+// an alpha plane (blended) or a sprite (only the pixels that are not the
+// key colour are copied). The compositor does not own the layers, which
+// must outlive it, and draws whatever they hold each time it composes.
+
+class Compositor
+{
+public:
+
+    size_t addLayer(const Image565& image, const Image565Point& p);
+    size_t addLayer(const Image565Alpha& image, const Image565Point& p);
+    size_t addLayer(const Sprite565& sprite, const Image565Point& p);
+
+    size_t getLayerCount() const { return m_layers.size(); }
+
+    void setPosition(size_t layer, const Image565Point& p);
+    void setVisible(size_t layer, bool visible);
+
+    void clear() { m_layers.clear(); }
+
+    // Draw the layers into destination. Only the part of destination in
+    // clip is drawn: layers are positioned relative to destination, not
+    // the clip rectangle. Layers beneath an opaque layer that covers the
+    // whole of the clip rectangle are skipped.
+
+    void compose(Image565View destination) const;
+
+    void
+    compose(
+        Image565View destination,
+        const Image565Rectangle& clip) const;
+
+private:
+
+    struct Layer
+    {
+        const Image565* m_opaque;
+        const Image565Alpha* m_alpha;
+        const Sprite565* m_sprite;
+        Image565Point m_position;
+        bool m_visible;
+    };
+
+    std::vector<Layer> m_layers;
+};
+
+//-------------------------------------------------------------------------
+
+} // namespace raspifb16
+
+//-------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,925 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#include <atomic>
+#include <cstring>
+#include <initializer_list>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CONVERT565_X86
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define CONVERT565_NEON
+#include <arm_neon.h>
+#endif
+
+#include "convert565.h"
+#include "pixelFormat.h"
+
+//-------------------------------------------------------------------------
+
+namespace
+{
+
+//-------------------------------------------------------------------------
+
+using namespace raspifb16;
+
+//-------------------------------------------------------------------------
+
+struct Kernels
+{
+    ConvertKernels m_kernels;
+    void (*m_rgb888ToRgb565)(uint16_t*, const uint8_t*, size_t);
+    void (*m_xrgb8888ToRgb565)(uint16_t*, const uint8_t*, size_t);
+    void (*m_rgb565ToXrgb8888)(uint8_t*, const uint16_t*, size_t, uint8_t);
+    void (*m_rgb565ToRgb888)(uint8_t*, const uint16_t*, size_t);
+};
+
+//-------------------------------------------------------------------------
+// Scalar kernels, which also finish off the last few pixels for the
+// vector kernels.
+
+void
+rgb888ToRgb565Scalar(
+    uint16_t* dst,
+    const uint8_t* src,
+    size_t length)
+{
+    for (size_t i = 0 ; i < length ; ++i)
+    {
+        dst[i] = RGB888Format::load(src + (i * 3));
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+xrgb8888ToRgb565Scalar(
+    uint16_t* dst,
+    const uint8_t* src,
+    size_t length)
+{
+    for (size_t i = 0 ; i < length ; ++i)
+    {
+        dst[i] = XRGB8888Format::load(src + (i * 4));
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+rgb565ToXrgb8888Scalar(
+    uint8_t* dst,
+    const uint16_t* src,
+    size_t length,
+    uint8_t x)
+{
+    const uint32_t high = uint32_t(x) << 24;
+
+    for (size_t i = 0 ; i < length ; ++i)
+    {
+        const uint32_t xrgb = XRGB8888Format::expand(src[i]) | high;
+        std::memcpy(dst + (i * 4), &xrgb, sizeof(xrgb));
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+rgb565ToRgb888Scalar(
+    uint8_t* dst,
+    const uint16_t* src,
+    size_t length)
+{
+    for (size_t i = 0 ; i < length ; ++i)
+    {
+        RGB888Format::store(dst + (i * 3), src[i]);
+    }
+}
+
+//-------------------------------------------------------------------------
+
+const Kernels scalarKernels
+{
+    ConvertKernels::SCALAR,
+    rgb888ToRgb565Scalar,
+    xrgb8888ToRgb565Scalar,
+    rgb565ToXrgb8888Scalar,
+    rgb565ToRgb888Scalar
+};
+
+//-------------------------------------------------------------------------
+
+#ifdef CONVERT565_X86
+
+//-------------------------------------------------------------------------
+// SSE2 kernels. A 24 bit pixel read as a little endian 32 bit word has
+// the same layout as XRGB8888 (with the next pixel's blue as X), so both
+// formats share the same arithmetic. Reading or writing four bytes for
+// each three byte pixel runs one byte past the last pixel, so those loops
+// stop one pixel early.
+
+inline uint32_t
+load32(
+    const uint8_t* p)
+{
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+
+    return value;
+}
+
+//-------------------------------------------------------------------------
+
+inline void
+store32(
+    uint8_t* p,
+    uint32_t value)
+{
+    std::memcpy(p, &value, sizeof(value));
+}
+
+//-------------------------------------------------------------------------
+
+// 565 from the low 24 bits of each 32 bit lane, sign extended so that
+// _mm_packs_epi32() keeps all 16 bits.
+
+__attribute__((target("sse2")))
+inline __m128i
+to565Sse2(
+    __m128i xrgb)
+{
+    const auto r = _mm_and_si128(_mm_srli_epi32(xrgb, 8),
+                                 _mm_set1_epi32(0xF800));
+    const auto g = _mm_and_si128(_mm_srli_epi32(xrgb, 5),
+                                 _mm_set1_epi32(0x07E0));
+    const auto b = _mm_and_si128(_mm_srli_epi32(xrgb, 3),
+                                 _mm_set1_epi32(0x001F));
+    const auto rgb = _mm_or_si128(_mm_or_si128(r, g), b);
+
+    return _mm_srai_epi32(_mm_slli_epi32(rgb, 16), 16);
+}
+
+//-------------------------------------------------------------------------
+
+// Widen eight 565 pixels to XRGB8888, four in lo and four in hi.
+
+__attribute__((target("sse2")))
+inline void
+expandSse2(
+    __m128i rgb,
+    __m128i xHigh,
+    __m128i& lo,
+    __m128i& hi)
+{
+    const auto r5 = _mm_srli_epi16(rgb, 11);
+    const auto g6 = _mm_and_si128(_mm_srli_epi16(rgb, 5),
+                                  _mm_set1_epi16(0x3F));
+    const auto b5 = _mm_and_si128(rgb, _mm_set1_epi16(0x1F));
+
+    const auto r8 = _mm_or_si128(_mm_slli_epi16(r5, 3), _mm_srli_epi16(r5, 2));
+    const auto g8 = _mm_or_si128(_mm_slli_epi16(g6, 2), _mm_srli_epi16(g6, 4));
+    const auto b8 = _mm_or_si128(_mm_slli_epi16(b5, 3), _mm_srli_epi16(b5, 2));
+
+    const auto bg = _mm_or_si128(b8, _mm_slli_epi16(g8, 8));
+    const auto rx = _mm_or_si128(r8, xHigh);
+
+    lo = _mm_unpacklo_epi16(bg, rx);
+    hi = _mm_unpackhi_epi16(bg, rx);
+}
+
+//-------------------------------------------------------------------------
+
+// Write the low three bytes of each lane, one pixel after another.
+
+__attribute__((target("sse2")))
+inline void
+storeRgb888Sse2(
+    uint8_t* p,
+    __m128i xrgb)
+{
+    store32(p, _mm_cvtsi128_si32(xrgb));
+    store32(p + 3, _mm_cvtsi128_si32(_mm_srli_si128(xrgb, 4)));
+    store32(p + 6, _mm_cvtsi128_si32(_mm_srli_si128(xrgb, 8)));
+    store32(p + 9, _mm_cvtsi128_si32(_mm_srli_si128(xrgb, 12)));
+}
+
+//-------------------------------------------------------------------------
+
+__attribute__((target("sse2")))
+void
+rgb888ToRgb565Sse2(
+    uint16_t* dst,
+    const uint8_t* src,
+    size_t length)
+{
+    size_t i{0};
+
+    for ( ; (i + 9) <= length ; i += 8)
+    {
+        const auto p = src + (i * 3);
+        const auto lo = _mm_setr_epi32(load32(p),
+                                       load32(p + 3),
+                                       load32(p + 6),
+                                       load32(p + 9));
+        const auto hi = _mm_setr_epi32(load32(p + 12),
+                                       load32(p + 15),
+                                       load32(p + 18),
+                                       load32(p + 21));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                         _mm_packs_epi32(to565Sse2(lo), to565Sse2(hi)));
+    }
+
+    rgb888ToRgb565Scalar(dst + i, src + (i * 3), length - i);
+}
+
+//-------------------------------------------------------------------------
+
+__attribute__((target("sse2")))
+void
+xrgb8888ToRgb565Sse2(
+    uint16_t* dst,
+    const uint8_t* src,
+    size_t length)
+{
+    size_t i{0};
+
+    for ( ; (i + 8) <= length ; i += 8)
+    {
+        const auto p = reinterpret_cast<const __m128i*>(src + (i * 4));
+        const auto lo = _mm_loadu_si128(p);
+        const auto hi = _mm_loadu_si128(p + 1);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                         _mm_packs_epi32(to565Sse2(lo), to565Sse2(hi)));
+    }
+
+    xrgb8888ToRgb565Scalar(dst + i, src + (i * 4), length - i);
+}
+
+//-------------------------------------------------------------------------
+
+__attribute__((target("sse2")))
+void
+rgb565ToXrgb8888Sse2(
+    uint8_t* dst,
+    const uint16_t* src,
+    size_t length,
+    uint8_t x)
+{
+    const auto xHigh = _mm_set1_epi16(static_cast<int16_t>(x << 8));
+    size_t i{0};
+
+    for ( ; (i + 8) <= length ; i += 8)
+    {
+        __m128i lo;
+        __m128i hi;
+
+        expandSse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)),
+                   xHigh,
+                   lo,
+                   hi);
+
+        const auto p = reinterpret_cast<__m128i*>(dst + (i * 4));
+        _mm_storeu_si128(p, lo);
+        _mm_storeu_si128(p + 1, hi);
+    }
+
+    rgb565ToXrgb8888Scalar(dst + (i * 4), src + i, length - i, x);
+}
+
+//-------------------------------------------------------------------------
+
+__attribute__((target("sse2")))
+void
+rgb565ToRgb888Sse2(
+    uint8_t* dst,
+    const uint16_t* src,
+    size_t length)
+{
+    const auto zero = _mm_setzero_si128();
+    size_t i{0};
+
+    for ( ; (i + 9) <= length ; i += 8)
+    {
+        __m128i lo;
+        __m128i hi;
+
+        expandSse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)),
+                   zero,
+                   lo,
+                   hi);
+
+        storeRgb888Sse2(dst + (i * 3), lo);
+        storeRgb888Sse2(dst + (i * 3) + 12, hi);
+    }
+
+    rgb565ToRgb888Scalar(dst + (i * 3), src + i, length - i);
+}
+
+//-------------------------------------------------------------------------
+
+const Kernels sse2Kernels
+{
+    ConvertKernels::SSE2,
+    rgb888ToRgb565Sse2,
+    xrgb8888ToRgb565Sse2,
+    rgb565ToXrgb8888Sse2,
+    rgb565ToRgb888Sse2
+};
+
+//-------------------------------------------------------------------------
+// AVX2 kernels, sixteen pixels at a time. Their shuffles and packs work
+// within each 128 bit lane, so results are put back in order with a
+// permute. Three byte pixels are moved with 16 byte loads and stores of
+// four pixels, which run four bytes past the end, so those loops stop
+// two pixels early. The SSE2 kernels finish each row.
+
+__attribute__((target("avx2")))
+inline __m256i
+to565Avx2(
+    __m256i xrgb)
+{
+    const auto r = _mm256_and_si256(_mm256_srli_epi32(xrgb, 8),
+                                    _mm256_set1_epi32(0xF800));
+    const auto g = _mm256_and_si256(_mm256_srli_epi32(xrgb, 5),
+                                    _mm256_set1_epi32(0x07E0));
+    const auto b = _mm256_and_si256(_mm256_srli_epi32(xrgb, 3),
+                                    _mm256_set1_epi32(0x001F));
+    const auto rgb = _mm256_or_si256(_mm256_or_si256(r, g), b);
+
+    return _mm256_srai_epi32(_mm256_slli_epi32(rgb, 16), 16);
+}
+
+//-------------------------------------------------------------------------
+
+__attribute__((target("avx2")))
+inline __m256i
+pack565Avx2(
+    __m256i lo,
+    __m256i hi)
+{
+    const auto packed = _mm256_packs_epi32(to565Avx2(lo), to565Avx2(hi));
+
+    return _mm256_permute4x64_epi64(packed, 0xD8);
+}
+
+//-------------------------------------------------------------------------
+
+// Eight three byte pixels, spread out to one per 32 bit lane.
+
+__attribute__((target("avx2")))
+inline __m256i
+loadRgb888Avx2(
+    const uint8_t* p)
+{
+    const auto spread = _mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1,
+                                         6, 7, 8, -1, 9, 10, 11, -1,
+                                         0, 1, 2, -1, 3, 4, 5, -1,
+                                         6, 7, 8, -1, 9, 10, 11, -1);
+
+    const auto lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    const auto hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 12));
+    const auto rgb = _mm256_inserti128_si256(_mm256_castsi128_si256(lo),
+                                             hi,
+                                             1);
+
+    return _mm256_shuffle_epi8(rgb, spread);
+}
+
+//-------------------------------------------------------------------------
+
+__attribute__((target("avx2")))
+inline void
+expandAvx2(
+    __m256i rgb,
+    __m256i xHigh,
+    __m256i& lo,
+    __m256i& hi)
+{
+    const auto r5 = _mm256_srli_epi16(rgb, 11);
+    const auto g6 = _mm256_and_si256(_mm256_srli_epi16(rgb, 5),
+                                     _mm256_set1_epi16(0x3F));
+    const auto b5 = _mm256_and_si256(rgb, _mm256_set1_epi16(0x1F));
+
+    const auto r8 = _mm256_or_si256(_mm256_slli_epi16(r5, 3),
+                                    _mm256_srli_epi16(r5, 2));
+    const auto g8 = _mm256_or_si256(_mm256_slli_epi16(g6, 2),
+                                    _mm256_srli_epi16(g6, 4));
+    const auto b8 = _mm256_or_si256(_mm256_slli_epi16(b5, 3),
+                                    _mm256_srli_epi16(b5, 2));
+
+    const auto bg = _mm256_or_si256(b8, _mm256_slli_epi16(g8, 8));
+    const auto rx = _mm256_or_si256(r8, xHigh);
+
+    const auto unpackedLo = _mm256_unpacklo_epi16(bg, rx);
+    const auto unpackedHi = _mm256_unpackhi_epi16(bg, rx);
+
+    lo = _mm256_permute2x128_si256(unpackedLo, unpackedHi, 0x20);
+    hi = _mm256_permute2x128_si256(unpackedLo, unpackedHi, 0x31);
+}
+
+//-------------------------------------------------------------------------
+
+// Write eight XRGB8888 pixels as three byte pixels.
+
+__attribute__((target("avx2")))
+inline void
+storeRgb888Avx2(
+    uint8_t* p,
+    __m256i xrgb)
+{
+    const auto compact = _mm256_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9,
+                                          10, 12, 13, 14, -1, -1, -1, -1,
+                                          0, 1, 2, 4, 5, 6, 8, 9,
+                                          10, 12, 13, 14, -1, -1, -1, -1);
+
+    const auto rgb = _mm256_shuffle_epi8(xrgb, compact);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p),
+                     _mm256_castsi256_si128(rgb));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p + 12),
+                     _mm256_extracti128_si256(rgb, 1));
+}
+
+//-------------------------------------------------------------------------
+
+__attribute__((target("avx2")))
+void
+rgb888ToRgb565Avx2(
+    uint16_t* dst,
+    const uint8_t* src,
+    size_t length)
+{
+    size_t i{0};
+
+    for ( ; (i + 18) <= length ; i += 16)
+    {
+        const auto p = src + (i * 3);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                            pack565Avx2(loadRgb888Avx2(p),
+                                        loadRgb888Avx2(p + 24)));
+    }
+
+    rgb888ToRgb565Sse2(dst + i, src + (i * 3), length - i);
+}
+
+//-------------------------------------------------------------------------
+
+__attribute__((target("avx2")))
+void
+xrgb8888ToRgb565Avx2(
+    uint16_t* dst,
+    const uint8_t* src,
+    size_t length)
+{
+    size_t i{0};
+
+    for ( ; (i + 16) <= length ; i += 16)
+    {
+        const auto p = reinterpret_cast<const __m256i*>(src + (i * 4));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                            pack565Avx2(_mm256_loadu_si256(p),
+                                        _mm256_loadu_si256(p + 1)));
+    }
+
+    xrgb8888ToRgb565Sse2(dst + i, src + (i * 4), length - i);
+}
+
+//-------------------------------------------------------------------------
+
+__attribute__((target("avx2")))
+void
+rgb565ToXrgb8888Avx2(
+    uint8_t* dst,
+    const uint16_t* src,
+    size_t length,
+    uint8_t x)
+{
+    const auto xHigh = _mm256_set1_epi16(static_cast<int16_t>(x << 8));
+    size_t i{0};
+
+    for ( ; (i + 16) <= length ; i += 16)
+    {
+        __m256i lo;
+        __m256i hi;
+
+        expandAvx2(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)),
+            xHigh,
+            lo,
+            hi);
+
+        const auto p = reinterpret_cast<__m256i*>(dst + (i * 4));
+        _mm256_storeu_si256(p, lo);
+        _mm256_storeu_si256(p + 1, hi);
+    }
+
+    rgb565ToXrgb8888Sse2(dst + (i * 4), src + i, length - i, x);
+}
+
+//-------------------------------------------------------------------------
+
+__attribute__((target("avx2")))
+void
+rgb565ToRgb888Avx2(
+    uint8_t* dst,
+    const uint16_t* src,
+    size_t length)
+{
+    const auto zero = _mm256_setzero_si256();
+    size_t i{0};
+
+    for ( ; (i + 18) <= length ; i += 16)
+    {
+        __m256i lo;
+        __m256i hi;
+
+        expandAvx2(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)),
+            zero,
+            lo,
+            hi);
+
+        storeRgb888Avx2(dst + (i * 3), lo);
+        storeRgb888Avx2(dst + (i * 3) + 24, hi);
+    }
+
+    rgb565ToRgb888Sse2(dst + (i * 3), src + i, length - i);
+}
+
+//-------------------------------------------------------------------------
+
+const Kernels avx2Kernels
+{
+    ConvertKernels::AVX2,
+    rgb888ToRgb565Avx2,
+    xrgb8888ToRgb565Avx2,
+    rgb565ToXrgb8888Avx2,
+    rgb565ToRgb888Avx2
+};
+
+#endif
+
+//-------------------------------------------------------------------------
+
+#ifdef CONVERT565_NEON
+
+//-------------------------------------------------------------------------
+// NEON kernels. The structure loads and stores split pixels into one
+// register per channel, and shift and insert builds or widens 565 in a
+// couple of instructions per channel.
+
+inline uint16x8_t
+pack565Neon(
+    uint8x8_t r,
+    uint8x8_t g,
+    uint8x8_t b)
+{
+    auto rgb = vshll_n_u8(r, 8);
+    rgb = vsriq_n_u16(rgb, vshll_n_u8(g, 8), 5);
+
+    return vsriq_n_u16(rgb, vshll_n_u8(b, 8), 11);
+}
+
+//-------------------------------------------------------------------------
+
+inline void
+expandNeon(
+    uint16x8_t rgb,
+    uint8x8_t& r,
+    uint8x8_t& g,
+    uint8x8_t& b)
+{
+    r = vshrn_n_u16(rgb, 8);
+    r = vsri_n_u8(r, r, 5);
+    g = vshrn_n_u16(rgb, 3);
+    g = vsri_n_u8(g, g, 6);
+    b = vmovn_u16(vshlq_n_u16(rgb, 3));
+    b = vsri_n_u8(b, b, 5);
+}
+
+//-------------------------------------------------------------------------
+
+void
+rgb888ToRgb565Neon(
+    uint16_t* dst,
+    const uint8_t* src,
+    size_t length)
+{
+    size_t i{0};
+
+    for ( ; (i + 16) <= length ; i += 16)
+    {
+        const auto bgr = vld3q_u8(src + (i * 3));
+
+        vst1q_u16(dst + i, pack565Neon(vget_low_u8(bgr.val[2]),
+                                       vget_low_u8(bgr.val[1]),
+                                       vget_low_u8(bgr.val[0])));
+        vst1q_u16(dst + i + 8, pack565Neon(vget_high_u8(bgr.val[2]),
+                                           vget_high_u8(bgr.val[1]),
+                                           vget_high_u8(bgr.val[0])));
+    }
+
+    rgb888ToRgb565Scalar(dst + i, src + (i * 3), length - i);
+}
+
+//-------------------------------------------------------------------------
+
+void
+xrgb8888ToRgb565Neon(
+    uint16_t* dst,
+    const uint8_t* src,
+    size_t length)
+{
+    size_t i{0};
+
+    for ( ; (i + 16) <= length ; i += 16)
+    {
+        const auto bgrx = vld4q_u8(src + (i * 4));
+
+        vst1q_u16(dst + i, pack565Neon(vget_low_u8(bgrx.val[2]),
+                                       vget_low_u8(bgrx.val[1]),
+                                       vget_low_u8(bgrx.val[0])));
+        vst1q_u16(dst + i + 8, pack565Neon(vget_high_u8(bgrx.val[2]),
+                                           vget_high_u8(bgrx.val[1]),
+                                           vget_high_u8(bgrx.val[0])));
+    }
+
+    xrgb8888ToRgb565Scalar(dst + i, src + (i * 4), length - i);
+}
+
+//-------------------------------------------------------------------------
+
+void
+rgb565ToXrgb8888Neon(
+    uint8_t* dst,
+    const uint16_t* src,
+    size_t length,
+    uint8_t x)
+{
+    uint8x8x4_t bgrx;
+    bgrx.val[3] = vdup_n_u8(x);
+    size_t i{0};
+
+    for ( ; (i + 8) <= length ; i += 8)
+    {
+        expandNeon(vld1q_u16(src + i), bgrx.val[2], bgrx.val[1], bgrx.val[0]);
+        vst4_u8(dst + (i * 4), bgrx);
+    }
+
+    rgb565ToXrgb8888Scalar(dst + (i * 4), src + i, length - i, x);
+}
+
+//-------------------------------------------------------------------------
+
+void
+rgb565ToRgb888Neon(
+    uint8_t* dst,
+    const uint16_t* src,
+    size_t length)
+{
+    uint8x8x3_t bgr;
+    size_t i{0};
+
+    for ( ; (i + 8) <= length ; i += 8)
+    {
+        expandNeon(vld1q_u16(src + i), bgr.val[2], bgr.val[1], bgr.val[0]);
+        vst3_u8(dst + (i * 3), bgr);
+    }
+
+    rgb565ToRgb888Scalar(dst + (i * 3), src + i, length - i);
+}
+
+//-------------------------------------------------------------------------
+
+const Kernels neonKernels
+{
+    ConvertKernels::NEON,
+    rgb888ToRgb565Neon,
+    xrgb8888ToRgb565Neon,
+    rgb565ToXrgb8888Neon,
+    rgb565ToRgb888Neon
+};
+
+#endif
+
+//-------------------------------------------------------------------------
+
+const Kernels*
+findKernels(
+    ConvertKernels kernels)
+{
+#ifdef CONVERT565_X86
+    __builtin_cpu_init();
+#endif
+
+    switch (kernels)
+    {
+    case ConvertKernels::SCALAR:
+
+        return &scalarKernels;
+
+    case ConvertKernels::SSE2:
+
+#ifdef CONVERT565_X86
+        if (__builtin_cpu_supports("sse2"))
+        {
+            return &sse2Kernels;
+        }
+#endif
+
+        break;
+
+    case ConvertKernels::AVX2:
+
+#ifdef CONVERT565_X86
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return &avx2Kernels;
+        }
+#endif
+
+        break;
+
+    case ConvertKernels::NEON:
+
+#ifdef CONVERT565_NEON
+        return &neonKernels;
+#endif
+
+        break;
+    }
+
+    return nullptr;
+}
+
+//-------------------------------------------------------------------------
+
+const Kernels*
+bestKernels()
+{
+    for (auto kernels : { ConvertKernels::AVX2,
+                          ConvertKernels::NEON,
+                          ConvertKernels::SSE2 })
+    {
+        auto found = findKernels(kernels);
+
+        if (found)
+        {
+            return found;
+        }
+    }
+
+    return &scalarKernels;
+}
+
+//-------------------------------------------------------------------------
+
+std::atomic<const Kernels*> currentKernels{nullptr};
+
+const Kernels&
+kernels()
+{
+    auto current = currentKernels.load(std::memory_order_relaxed);
+
+    if (current == nullptr)
+    {
+        current = bestKernels();
+        currentKernels.store(current, std::memory_order_relaxed);
+    }
+
+    return *current;
+}
+
+//-------------------------------------------------------------------------
+
+} // namespace
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::rgb888ToRgb565(
+    uint16_t* dst,
+    const uint8_t* src,
+    size_t length)
+{
+    kernels().m_rgb888ToRgb565(dst, src, length);
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::xrgb8888ToRgb565(
+    uint16_t* dst,
+    const uint8_t* src,
+    size_t length)
+{
+    kernels().m_xrgb8888ToRgb565(dst, src, length);
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::rgb565ToXrgb8888(
+    uint8_t* dst,
+    const uint16_t* src,
+    size_t length,
+    uint8_t x)
+{
+    kernels().m_rgb565ToXrgb8888(dst, src, length, x);
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::rgb565ToRgb888(
+    uint8_t* dst,
+    const uint16_t* src,
+    size_t length)
+{
+    kernels().m_rgb565ToRgb888(dst, src, length);
+}
+
+//-------------------------------------------------------------------------
+
+const char*
+raspifb16::convertKernelsName(
+    ConvertKernels kernels)
+{
+    switch (kernels)
+    {
+    case ConvertKernels::SCALAR:
+
+        return "scalar";
+
+    case ConvertKernels::SSE2:
+
+        return "SSE2";
+
+    case ConvertKernels::AVX2:
+
+        return "AVX2";
+
+    case ConvertKernels::NEON:
+
+        return "NEON";
+    }
+
+    return "unknown";
+}
+
+//-------------------------------------------------------------------------
+
+raspifb16::ConvertKernels
+raspifb16::getConvertKernels()
+{
+    return kernels().m_kernels;
+}
+
+//-------------------------------------------------------------------------
+
+bool
+raspifb16::setConvertKernels(
+    ConvertKernels kernels)
+{
+    auto found = findKernels(kernels);
+
+    if (found)
+    {
+        currentKernels.store(found, std::memory_order_relaxed);
+    }
+
+    return found != nullptr;
+}
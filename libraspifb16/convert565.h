@@ -0,0 +1,88 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef CONVERT565_H
+#define CONVERT565_H
+
+//-------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+
+//-------------------------------------------------------------------------
+
+namespace raspifb16
+{
+
+//-------------------------------------------------------------------------
+
+// Bulk conversion between RGB565 and the 24 and 32 bit pixel formats, in
+// the same layouts as PixelFormat::RGB888 and PixelFormat::XRGB8888. That
+// is 0xRRGGBB and 0xXXRRGGBB in little endian byte order, so the bytes of
+// each pixel are blue, green, red (and X). Eight bit channels are
+// truncated to 565, and 565 channels are widened by repeating their top
+// bits, exactly as RGB565 does for a single pixel.
+//
+// The kernels are chosen at run time, the first time they are used: AVX2
+// or SSE2 on x86, NEON on ARM when built for it, otherwise scalar loops.
+
+void rgb888ToRgb565(uint16_t* dst, const uint8_t* src, size_t length);
+void xrgb8888ToRgb565(uint16_t* dst, const uint8_t* src, size_t length);
+
+// The X byte of each pixel is set to x, so 0xFF gives opaque ARGB8888.
+
+void
+rgb565ToXrgb8888(
+    uint8_t* dst,
+    const uint16_t* src,
+    size_t length,
+    uint8_t x = 0);
+
+void rgb565ToRgb888(uint8_t* dst, const uint16_t* src, size_t length);
+
+//-------------------------------------------------------------------------
+
+enum class ConvertKernels { SCALAR, SSE2, AVX2, NEON };
+
+const char* convertKernelsName(ConvertKernels kernels);
+
+ConvertKernels getConvertKernels();
+
+// Use a particular set of kernels, for example to compare them. Returns
+// false, leaving the kernels unchanged, if this CPU or build does not
+// support them.
+
+bool setConvertKernels(ConvertKernels kernels);
+
+//-------------------------------------------------------------------------
+
+} // namespace raspifb16
+
+//-------------------------------------------------------------------------
+
+#endif
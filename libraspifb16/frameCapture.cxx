@@ -0,0 +1,324 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+
+#include <cerrno>
+#include <deque>
+
+#include "frameCapture.h"
+
+//-------------------------------------------------------------------------
+
+namespace
+{
+
+//-------------------------------------------------------------------------
+
+bool
+sameImage(
+    const raspifb16::Image565& a,
+    const raspifb16::Image565& b)
+{
+    for (int16_t j = 0 ; j < a.getHeight() ; ++j)
+    {
+        if (memcmp(a.getRow(j),
+                   b.getRow(j),
+                   a.getWidth() * sizeof(uint16_t)) != 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------
+
+size_t
+pipeSize(
+    int fd)
+{
+    struct stat status;
+
+    if ((::fstat(fd, &status) == -1) || !S_ISFIFO(status.st_mode))
+    {
+        return 0;
+    }
+
+    auto size = ::fcntl(fd, F_GETPIPE_SZ);
+
+    return (size > 0) ? size : 0;
+}
+
+//-------------------------------------------------------------------------
+
+} // namespace
+
+//-------------------------------------------------------------------------
+
+raspifb16::FrameCapture:: FrameCapture(
+    const FrameBuffer565& fb,
+    int fd,
+    bool onlyOnChange)
+:
+    m_fb(fb),
+    m_fd{fd},
+    m_onlyOnChange{onlyOnChange},
+    m_pipeSize{pipeSize(fd)},
+    m_isPipe{m_pipeSize > 0},
+    m_frameSize(fb.getWidth() * fb.getHeight() * sizeof(uint16_t)),
+    m_buffers{},
+    m_ready{bufferCount()},
+    m_free{bufferCount()},
+    m_mutex{},
+    m_wakeUp{},
+    m_running{true},
+    m_captured{0},
+    m_written{0},
+    m_unchanged{0},
+    m_dropped{0},
+    m_errors{0},
+    m_thread{}
+{
+    auto count = bufferCount();
+
+    m_buffers.reserve(count);
+
+    // Packed, so that writeFrame() can send each frame as one block.
+
+    for (size_t i = 0 ; i < count ; ++i)
+    {
+        m_buffers.emplace_back(fb.getWidth(),
+                               fb.getHeight(),
+                               Image565::Layout::PACKED);
+        release(i);
+    }
+
+    m_thread = std::thread(&FrameCapture::run, this);
+}
+
+//-------------------------------------------------------------------------
+
+raspifb16::FrameCapture:: ~FrameCapture()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running = false;
+    }
+
+    m_wakeUp.notify_one();
+    m_thread.join();
+}
+
+//-------------------------------------------------------------------------
+
+bool
+raspifb16::FrameCapture:: capture()
+{
+    auto buffer = m_free.front();
+
+    if (buffer == nullptr)
+    {
+        ++m_dropped;
+        return false;
+    }
+
+    auto index = *buffer;
+    m_free.pop();
+
+    m_fb.snapshot(m_buffers[index]);
+    ++m_captured;
+
+    *m_ready.back() = index;
+    m_ready.push();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+    }
+
+    m_wakeUp.notify_one();
+
+    return true;
+}
+
+//-------------------------------------------------------------------------
+
+raspifb16::CaptureStatistics
+raspifb16::FrameCapture:: getStatistics() const
+{
+    return CaptureStatistics
+    {
+        m_captured,
+        m_written,
+        m_unchanged,
+        m_dropped,
+        m_errors
+    };
+}
+
+//-------------------------------------------------------------------------
+
+size_t
+raspifb16::FrameCapture:: bufferCount() const
+{
+    // One buffer being filled, one waiting to be written, the last frame
+    // written (kept to compare against) and enough to cover what may
+    // still be sitting in the pipe.
+
+    return 3 + ((m_pipeSize + m_frameSize - 1) / m_frameSize);
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::FrameCapture:: release(
+    size_t buffer)
+{
+    // There are as many free slots as buffers, so this cannot fail.
+
+    *m_free.back() = buffer;
+    m_free.push();
+}
+
+//-------------------------------------------------------------------------
+
+size_t
+raspifb16::FrameCapture:: writeFrame(
+    const Image565& image)
+{
+    auto data = reinterpret_cast<const uint8_t*>(image.getRow(0));
+    size_t written{0};
+
+    while (written < m_frameSize)
+    {
+        ssize_t result{-1};
+
+        if (m_isPipe)
+        {
+            struct iovec iov;
+            iov.iov_base = const_cast<uint8_t*>(data + written);
+            iov.iov_len = m_frameSize - written;
+
+            result = ::vmsplice(m_fd, &iov, 1, 0);
+        }
+        else
+        {
+            result = ::write(m_fd, data + written, m_frameSize - written);
+        }
+
+        if (result == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            break;
+        }
+
+        written += result;
+    }
+
+    return written;
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::FrameCapture:: run()
+{
+    // Buffers that have been written, oldest first, along with the total
+    // number of bytes written when each was finished.
+
+    std::deque<InFlight> inFlight;
+    uint64_t total{0};
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true)
+    {
+        m_wakeUp.wait(lock, [this] { return !m_running || !m_ready.empty(); });
+
+        if (m_ready.empty())
+        {
+            break;
+        }
+
+        lock.unlock();
+
+        for (auto buffer = m_ready.front() ;
+             buffer != nullptr ;
+             buffer = m_ready.front())
+        {
+            auto index = *buffer;
+            m_ready.pop();
+
+            if (m_onlyOnChange &&
+                !inFlight.empty() &&
+                sameImage(m_buffers[index],
+                          m_buffers[inFlight.back().m_buffer]))
+            {
+                ++m_unchanged;
+                release(index);
+
+                continue;
+            }
+
+            auto written = writeFrame(m_buffers[index]);
+            total += written;
+
+            if (written == m_frameSize)
+            {
+                ++m_written;
+            }
+            else
+            {
+                ++m_errors;
+            }
+
+            inFlight.push_back(InFlight{index, total});
+
+            // The pipe holds at most m_pipeSize bytes, so anything that
+            // far behind the total has been read. The last frame is kept.
+
+            while ((inFlight.size() > 1) &&
+                   ((inFlight.front().m_end + m_pipeSize) <= total))
+            {
+                release(inFlight.front().m_buffer);
+                inFlight.pop_front();
+            }
+        }
+
+        lock.lock();
+    }
+}
@@ -0,0 +1,139 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef FRAME_CAPTURE_H
+#define FRAME_CAPTURE_H
+
+//-------------------------------------------------------------------------
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "framebuffer565.h"
+#include "image565.h"
+#include "spscQueue.h"
+
+//-------------------------------------------------------------------------
+
+namespace raspifb16
+{
+
+//-------------------------------------------------------------------------
+
+struct CaptureStatistics
+{
+    uint64_t m_captured;
+    uint64_t m_written;
+    uint64_t m_unchanged;
+    uint64_t m_dropped;
+    uint64_t m_errors;
+};
+
+//-------------------------------------------------------------------------
+
+// Streams raw RGB565 frames (width x height pixels, no header) from a
+// framebuffer to a file descriptor on a thread of its own.
+//
+// capture() copies the visible frame into a free buffer and hands it to
+// the capture thread. It never waits for I/O, if no buffer is free the
+// frame is dropped. When fd is a pipe, frames are moved into it with
+// vmsplice() rather than copied, so a buffer is not reused until enough
+// has been written after it to have pushed it out of the pipe. Other
+// descriptors are written with write().
+//
+// With onlyOnChange, a frame that is identical to the last one written
+// is skipped. Writing to a pipe with no reader raises SIGPIPE.
+
+class FrameCapture
+{
+public:
+
+    FrameCapture(
+        const FrameBuffer565& fb,
+        int fd,
+        bool onlyOnChange = false);
+
+    ~FrameCapture();
+
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator= (const FrameCapture&) = delete;
+
+    bool capture();
+
+    bool isPipe() const { return m_isPipe; }
+
+    CaptureStatistics getStatistics() const;
+
+private:
+
+    struct InFlight
+    {
+        size_t m_buffer;
+        uint64_t m_end;
+    };
+
+    size_t bufferCount() const;
+    void run();
+    size_t writeFrame(const Image565& image);
+    void release(size_t buffer);
+
+    const FrameBuffer565& m_fb;
+    int m_fd;
+    bool m_onlyOnChange;
+    size_t m_pipeSize;
+    bool m_isPipe;
+    size_t m_frameSize;
+
+    std::vector<Image565> m_buffers;
+    SpscQueue<size_t> m_ready;
+    SpscQueue<size_t> m_free;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeUp;
+    bool m_running;
+
+    std::atomic<uint64_t> m_captured;
+    std::atomic<uint64_t> m_written;
+    std::atomic<uint64_t> m_unchanged;
+    std::atomic<uint64_t> m_dropped;
+    std::atomic<uint64_t> m_errors;
+
+    std::thread m_thread;
+};
+
+//-------------------------------------------------------------------------
+
+} // namespace raspifb16
+
+//-------------------------------------------------------------------------
+
+#endif
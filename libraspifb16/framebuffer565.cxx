@@ -37,58 +37,107 @@
 #include <sys/mman.h>
 
 #include <algorithm>
+#include <chrono>
+#include <regex>
+#include <stdexcept>
 #include <string>
 #include <system_error>
+#include <thread>
 
+#include "blend565.h"
+#include "blit565.h"
 #include "framebuffer565.h"
 #include "image565.h"
+#include "image565Alpha.h"
+#include "image565View.h"
+#include "mappedImage565.h"
+#include "pixelFormat.h"
+#include "rle565.h"
 #include "point.h"
+#include "scale565.h"
+#include "sprite565.h"
 
 //-------------------------------------------------------------------------
 
 raspifb16::FrameBuffer565:: FrameBuffer565(
-    const std::string& device)
+    const std::string& device,
+    Buffering buffering)
 :
+    m_fbfd{-1},
     m_consolefd{-1},
     m_finfo{},
     m_vinfo{},
-    m_lineLengthPixels{0},
-    m_fbp{nullptr}
+    m_vinfoOriginal{},
+    m_kernels{nullptr},
+    m_isDevice{false},
+    m_buffering{buffering},
+    m_pageFlipping{false},
+    m_fbp{nullptr},
+    m_drawRow{0},
+    m_backBuffer{},
+    m_shadowEnabled{false},
+    m_shadow{},
+    m_bytesWritten{0},
+    m_vsyncEnabled{false},
+    m_vsyncSupported{true},
+    m_framePeriod{std::chrono::nanoseconds(1000000000 / 60)},
+    m_pacerOrigin{std::chrono::steady_clock::now()},
+    m_presentStatistics{0,
+                        0,
+                        std::chrono::nanoseconds::zero(),
+                        std::chrono::nanoseconds::max(),
+                        std::chrono::nanoseconds::zero(),
+                        std::chrono::nanoseconds::zero(),
+                        std::chrono::nanoseconds::zero()},
+    m_flushMode{FlushMode::NONE},
+    m_pageSize{static_cast<size_t>(::sysconf(_SC_PAGESIZE))},
+    m_dirtyPages{},
+    m_putImageCounter{},
+    m_clearCounter{},
+    m_flushCounter{}
 {
-    FileDescriptor fbfd{::open(device.c_str(), O_RDWR)};
+    m_isDevice = !openSurface(device);
 
-    if (fbfd.fd() == -1)
+    if (m_isDevice)
     {
-        throw std::system_error{errno,
-                                std::system_category(), 
-                                "cannot open framebuffer device " + device};
+        openDevice(device);
     }
 
-    if (ioctl(fbfd.fd(), FBIOGET_FSCREENINFO, &(m_finfo)) == -1)
+    m_vinfoOriginal = m_vinfo;
+    m_kernels = &pixelKernels(pixelFormat(m_vinfo));
+
+    //---------------------------------------------------------------------
+
+    uint64_t htotal = m_vinfo.xres
+                    + m_vinfo.left_margin
+                    + m_vinfo.right_margin
+                    + m_vinfo.hsync_len;
+
+    uint64_t vtotal = m_vinfo.yres
+                    + m_vinfo.upper_margin
+                    + m_vinfo.lower_margin
+                    + m_vinfo.vsync_len;
+
+    if (m_vinfo.pixclock != 0)
     {
-        throw std::system_error{errno,
-                                std::system_category(), 
-                                "reading fixed framebuffer information"};
+        // pixclock is the length of one pixel in picoseconds.
+
+        m_framePeriod = std::chrono::nanoseconds(
+            (htotal * vtotal * m_vinfo.pixclock) / 1000);
     }
 
-    if (ioctl(fbfd.fd(), FBIOGET_VSCREENINFO, &(m_vinfo)) == -1)
+    if (m_isDevice && (m_buffering == Buffering::DOUBLE))
     {
-        throw std::system_error{errno,
-                                std::system_category(), 
-                                "reading variable framebuffer information"};
+        m_pageFlipping = setupPageFlipping();
     }
 
     //---------------------------------------------------------------------
 
-    m_lineLengthPixels = m_finfo.line_length / bytesPerPixel;
-
-    //---------------------------------------------------------------------
-
     void* fbp = ::mmap(nullptr,
                        m_finfo.smem_len,
                        PROT_READ | PROT_WRITE,
                        MAP_SHARED,
-                       fbfd.fd(),
+                       m_fbfd.fd(),
                        0);
 
     if (fbp == MAP_FAILED)
@@ -98,7 +147,21 @@ raspifb16::FrameBuffer565:: FrameBuffer565(
                                 "mapping framebuffer device to memory");
     }
 
-    m_fbp = static_cast<uint16_t*>(fbp);
+    m_fbp = static_cast<uint8_t*>(fbp);
+    m_drawRow = visibleRow();
+    m_dirtyPages.resize((m_finfo.smem_len + m_pageSize - 1) / m_pageSize);
+
+    if (m_buffering == Buffering::DOUBLE)
+    {
+        if (m_pageFlipping)
+        {
+            m_drawRow = (visibleRow() == 0) ? m_vinfo.yres : 0;
+        }
+        else
+        {
+            createBackBuffer(visibleRow());
+        }
+    }
 }
 
 //-------------------------------------------------------------------------
@@ -107,6 +170,11 @@ raspifb16::FrameBuffer565:: ~FrameBuffer565()
 {
     ::munmap(m_fbp, m_finfo.smem_len);
 
+    if (m_isDevice && (m_buffering == Buffering::DOUBLE))
+    {
+        ::ioctl(m_fbfd.fd(), FBIOPUT_VSCREENINFO, &m_vinfoOriginal);
+    }
+
     if (m_consolefd.fd() != -1)
     {
         ::ioctl(m_consolefd.fd(), KDSETMODE, KD_TEXT);
@@ -115,6 +183,175 @@ raspifb16::FrameBuffer565:: ~FrameBuffer565()
 
 //-------------------------------------------------------------------------
 
+void
+raspifb16::FrameBuffer565:: openDevice(
+    const std::string& device)
+{
+    m_fbfd = FileDescriptor{::open(device.c_str(), O_RDWR)};
+
+    if (m_fbfd.fd() == -1)
+    {
+        throw std::system_error{errno,
+                                std::system_category(), 
+                                "cannot open framebuffer device " + device};
+    }
+
+    if (ioctl(m_fbfd.fd(), FBIOGET_FSCREENINFO, &(m_finfo)) == -1)
+    {
+        throw std::system_error{errno,
+                                std::system_category(), 
+                                "reading fixed framebuffer information"};
+    }
+
+    if (ioctl(m_fbfd.fd(), FBIOGET_VSCREENINFO, &(m_vinfo)) == -1)
+    {
+        throw std::system_error{errno,
+                                std::system_category(), 
+                                "reading variable framebuffer information"};
+    }
+}
+
+//-------------------------------------------------------------------------
+
+bool
+raspifb16::FrameBuffer565:: openSurface(
+    const std::string& device)
+{
+    static const std::regex memoryPattern{
+        R"(mem:(\d+)x(\d+)(x(\d+))?(:(\d+))?)"};
+    static const std::regex filePattern{
+        R"(file:(.+):(\d+)x(\d+)(x(\d+))?(:(\d+))?)"};
+
+    std::smatch match;
+    std::string path;
+
+    if (std::regex_match(device, match, memoryPattern))
+    {
+        m_fbfd = FileDescriptor{::memfd_create("raspifb16", MFD_CLOEXEC)};
+    }
+    else if (std::regex_match(device, match, filePattern))
+    {
+        path = match[1];
+        m_fbfd = FileDescriptor{::open(path.c_str(), O_RDWR | O_CREAT, 0644)};
+    }
+    else
+    {
+        return false;
+    }
+
+    auto index = path.empty() ? 1 : 2;
+    uint32_t width = std::stoul(match[index]);
+    uint32_t height = std::stoul(match[index + 1]);
+    uint32_t bitsPerPixel = 16;
+    uint32_t stride = width;
+
+    if (match[index + 3].matched)
+    {
+        bitsPerPixel = std::stoul(match[index + 3]);
+    }
+
+    if (match[index + 5].matched)
+    {
+        stride = std::stoul(match[index + 5]);
+    }
+
+    if ((width == 0) || (height == 0) || (stride < width))
+    {
+        throw std::invalid_argument{"bad surface geometry " + device};
+    }
+
+    m_vinfo.bits_per_pixel = bitsPerPixel;
+
+    switch (bitsPerPixel)
+    {
+    case 16:
+
+        m_vinfo.red = { 11, 5, 0 };
+        m_vinfo.green = { 5, 6, 0 };
+        m_vinfo.blue = { 0, 5, 0 };
+
+        break;
+
+    case 24:
+    case 32:
+
+        m_vinfo.red = { 16, 8, 0 };
+        m_vinfo.green = { 8, 8, 0 };
+        m_vinfo.blue = { 0, 8, 0 };
+
+        break;
+
+    default:
+
+        throw std::invalid_argument{"bad surface depth " + device};
+    }
+
+    if (m_fbfd.fd() == -1)
+    {
+        throw std::system_error{errno,
+                                std::system_category(), 
+                                "cannot create surface " + device};
+    }
+
+    //---------------------------------------------------------------------
+
+    m_finfo.type = FB_TYPE_PACKED_PIXELS;
+    m_finfo.visual = FB_VISUAL_TRUECOLOR;
+    m_finfo.line_length = stride * (bitsPerPixel / 8);
+    m_finfo.smem_len = m_finfo.line_length * height;
+
+    m_vinfo.xres = width;
+    m_vinfo.yres = height;
+    m_vinfo.xres_virtual = width;
+    m_vinfo.yres_virtual = height;
+
+    if (::ftruncate(m_fbfd.fd(), m_finfo.smem_len) == -1)
+    {
+        throw std::system_error{errno,
+                                std::system_category(), 
+                                "sizing surface " + device};
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------
+
+bool
+raspifb16::FrameBuffer565:: setupPageFlipping()
+{
+    struct fb_var_screeninfo vinfo = m_vinfo;
+
+    vinfo.yres_virtual = 2 * vinfo.yres;
+    vinfo.xoffset = 0;
+    vinfo.yoffset = 0;
+
+    if (ioctl(m_fbfd.fd(), FBIOPUT_VSCREENINFO, &vinfo) == -1)
+    {
+        return false;
+    }
+
+    // The driver may have adjusted the request (and reallocated its
+    // memory), so read back what it actually gave us.
+
+    if ((ioctl(m_fbfd.fd(), FBIOGET_FSCREENINFO, &(m_finfo)) == -1) ||
+        (ioctl(m_fbfd.fd(), FBIOGET_VSCREENINFO, &vinfo) == -1))
+    {
+        throw std::system_error{errno,
+                                std::system_category(), 
+                                "reading framebuffer information"};
+    }
+
+    m_vinfo = vinfo;
+
+    return (m_vinfo.yres_virtual >= (2 * m_vinfo.yres)) &&
+           (m_finfo.smem_len >= (2 * m_vinfo.yres * m_finfo.line_length)) &&
+           (m_finfo.ypanstep != 0) &&
+           ((m_vinfo.yres % m_finfo.ypanstep) == 0);
+}
+
+//-------------------------------------------------------------------------
+
 bool
 raspifb16::FrameBuffer565:: hideCursor()
 {
@@ -154,7 +391,18 @@ void
 raspifb16::FrameBuffer565:: clear(
     uint16_t rgb) const
 {
-    std::fill(m_fbp, m_fbp + (m_finfo.smem_len / bytesPerPixel), rgb);
+    m_bytesWritten = 0;
+    CallTimer timer{m_clearCounter};
+
+    // Only the page being drawn, so that when double buffered the clear
+    // is not seen until present().
+
+    for (int32_t j = 0 ; j < getHeight() ; ++j)
+    {
+        m_bytesWritten += fillSpan(0, j, rgb, getWidth());
+    }
+
+    timer.count(getWidth() * getHeight(), m_bytesWritten);
 }
 
 //-------------------------------------------------------------------------
@@ -168,7 +416,7 @@ raspifb16::FrameBuffer565:: setPixel(
 
     if (isValid)
     {
-        m_fbp[p.x() + p.y() * m_lineLengthPixels] = rgb;
+        drawSpan(p.x(), p.y(), &rgb, 1);
     }
 
     return isValid;
@@ -185,7 +433,9 @@ raspifb16::FrameBuffer565:: getPixelRGB(
 
     if (isValid)
     {
-        rgb.set565(m_fbp[p.x() + p.y() * m_lineLengthPixels]);
+        uint16_t value{0};
+        readSpan(p.x(), p.y(), &value, 1);
+        rgb.set565(value);
     }
 
     return std::make_pair(isValid, rgb);
@@ -202,7 +452,7 @@ raspifb16::FrameBuffer565:: getPixel(
 
     if (isValid)
     {
-        rgb = m_fbp[p.x() + p.y() * m_lineLengthPixels];
+        readSpan(p.x(), p.y(), &rgb, 1);
     }
 
     return std::make_pair(isValid, rgb);
@@ -215,25 +465,85 @@ raspifb16::FrameBuffer565:: putImage(
     const FB565Point& p,
     const Image565& image) const
 {
-    if ((p.x() < 0) ||
-        ((p.x() + image.getWidth()) > static_cast<int32_t>(m_vinfo.xres)))
+    return putImage(p,
+                    image,
+                    Image565Rectangle(0,
+                                      0,
+                                      image.getWidth(),
+                                      image.getHeight()));
+}
+
+//-------------------------------------------------------------------------
+
+bool
+raspifb16::FrameBuffer565:: putImage(
+    const FB565Point& p,
+    const Image565& image,
+    const Image565Rectangle& rectangle) const
+{
+    m_bytesWritten = 0;
+    CallTimer timer{m_putImageCounter};
+
+    BlitRegion region{rectangle.x(),
+                      rectangle.y(),
+                      p.x(),
+                      p.y(),
+                      rectangle.width(),
+                      rectangle.height()};
+
+    if (!clipBlit(region,
+                  image.getWidth(),
+                  image.getHeight(),
+                  getWidth(),
+                  getHeight()))
     {
-        return putImagePartial(p, image);
+        return false;
     }
 
-    if ((p.y() < 0) ||
-        ((p.y() + image.getHeight()) > static_cast<int32_t>(m_vinfo.yres)))
+    for (int32_t j = 0 ; j < region.m_height ; ++j)
     {
-        return putImagePartial(p, image);
+        m_bytesWritten += drawSpan(region.m_dstX,
+                                   region.m_dstY + j,
+                                   image.getRow(region.m_srcY + j)
+                                   + region.m_srcX,
+                                   region.m_width);
     }
 
-    for (int32_t j = 0 ; j < image.getHeight() ; ++j)
+    timer.count(region.m_width * region.m_height, m_bytesWritten);
+
+    return true;
+}
+
+//-------------------------------------------------------------------------
+
+bool
+raspifb16::FrameBuffer565:: getImage(
+    const FB565Rectangle& rectangle,
+    Image565& image,
+    const Image565Point& p) const
+{
+    BlitRegion region{rectangle.x(),
+                      rectangle.y(),
+                      p.x(),
+                      p.y(),
+                      rectangle.width(),
+                      rectangle.height()};
+
+    if (!clipBlit(region,
+                  getWidth(),
+                  getHeight(),
+                  image.getWidth(),
+                  image.getHeight()))
     {
-        auto start = image.getRow(j);
+        return false;
+    }
 
-        std::copy(start,
-                  start + image.getWidth(), 
-                  m_fbp + ((j + p.y()) * m_lineLengthPixels) + p.x());
+    for (int32_t j = 0 ; j < region.m_height ; ++j)
+    {
+        readSpan(region.m_srcX,
+                 region.m_srcY + j,
+                 image.getRow(region.m_dstY + j) + region.m_dstX,
+                 region.m_width);
     }
 
     return true;
@@ -242,61 +552,1096 @@ raspifb16::FrameBuffer565:: putImage(
 //-------------------------------------------------------------------------
 
 bool
-raspifb16::FrameBuffer565:: putImagePartial(
+raspifb16::FrameBuffer565:: putImage(
     const FB565Point& p,
-    const Image565& image) const
+    const Image565& image,
+    Rotation rotation) const
 {
-    auto x = p.x();
-    auto xStart = 0;
-    auto xEnd = image.getWidth() - 1;
+    if (rotation == Rotation::ROTATE_0)
+    {
+        return putImage(p, image);
+    }
+
+    m_bytesWritten = 0;
+    CallTimer timer{m_putImageCounter};
 
-    auto y = p.y();
-    auto yStart = 0;
-    auto yEnd = image.getHeight() - 1;
+    bool quarterTurn = (rotation == Rotation::ROTATE_90) ||
+                       (rotation == Rotation::ROTATE_270);
 
-    if (x < 0)
+    int32_t imageWidth = image.getWidth();
+    int32_t imageHeight = image.getHeight();
+    int32_t width = (quarterTurn) ? imageHeight : imageWidth;
+    int32_t height = (quarterTurn) ? imageWidth : imageHeight;
+
+    int32_t x0 = std::max(p.x(), 0);
+    int32_t x1 = std::min(p.x() + width, getWidth());
+    int32_t y0 = std::max(p.y(), 0);
+    int32_t y1 = std::min(p.y() + height, getHeight());
+
+    if ((x0 >= x1) || (y0 >= y1))
+    {
+        return false;
+    }
+
+    // Rotated rows are assembled a strip of tileSize rows at a time. For
+    // quarter turns the strip is filled one tileSize square at a time, so
+    // the source is read in short runs from a handful of rows, and the
+    // framebuffer is then written a whole row at a time.
+
+    constexpr int32_t tileSize{16};
+
+    int32_t length = x1 - x0;
+    std::vector<uint16_t> strip(tileSize * length);
+
+    for (int32_t ty = y0 ; ty < y1 ; ty += tileSize)
     {
-        xStart = -x;
-        x = 0;
+        int32_t rows = std::min(tileSize, y1 - ty);
+        int32_t dy = ty - p.y();
+
+        if (rotation == Rotation::ROTATE_180)
+        {
+            int32_t dx = x0 - p.x();
+
+            for (int32_t r = 0 ; r < rows ; ++r)
+            {
+                auto row = image.getRow(imageHeight - 1 - (dy + r));
+
+                std::reverse_copy(row + imageWidth - dx - length,
+                                  row + imageWidth - dx,
+                                  strip.data() + (r * length));
+            }
+        }
+        else
+        {
+            for (int32_t tx = x0 ; tx < x1 ; tx += tileSize)
+            {
+                int32_t columns = std::min(tileSize, x1 - tx);
+                int32_t dx = tx - p.x();
+                auto tile = strip.data() + (tx - x0);
+
+                for (int32_t c = 0 ; c < columns ; ++c)
+                {
+                    if (rotation == Rotation::ROTATE_90)
+                    {
+                        auto row = image.getRow(imageHeight - 1 - (dx + c));
+
+                        for (int32_t r = 0 ; r < rows ; ++r)
+                        {
+                            tile[(r * length) + c] = row[dy + r];
+                        }
+                    }
+                    else
+                    {
+                        auto row = image.getRow(dx + c) + imageWidth - 1 - dy;
+
+                        for (int32_t r = 0 ; r < rows ; ++r)
+                        {
+                            tile[(r * length) + c] = *(row - r);
+                        }
+                    }
+                }
+            }
+        }
+
+        for (int32_t r = 0 ; r < rows ; ++r)
+        {
+            m_bytesWritten += drawSpan(x0,
+                                       ty + r,
+                                       strip.data() + (r * length),
+                                       length);
+        }
     }
 
-    if ((x - xStart + image.getWidth()) >
-        static_cast<int32_t>(m_vinfo.xres))
+    timer.count(length * (y1 - y0), m_bytesWritten);
+
+    return true;
+}
+
+//-------------------------------------------------------------------------
+
+bool
+raspifb16::FrameBuffer565:: putImage(
+    const FB565Point& p,
+    const Image565& image,
+    int32_t width,
+    int32_t height,
+    ScaleFilter filter) const
+{
+    m_bytesWritten = 0;
+    CallTimer timer{m_putImageCounter};
+
+    int32_t imageWidth = image.getWidth();
+    int32_t imageHeight = image.getHeight();
+
+    if ((width <= 0) ||
+        (height <= 0) ||
+        (imageWidth <= 0) ||
+        (imageHeight <= 0))
     {
-        xEnd = m_vinfo.xres - 1 - (x - xStart);
+        return false;
     }
 
-    if (y < 0)
+    int32_t x0 = std::max(p.x(), 0);
+    int32_t x1 = std::min(p.x() + width, getWidth());
+    int32_t y0 = std::max(p.y(), 0);
+    int32_t y1 = std::min(p.y() + height, getHeight());
+
+    if ((x0 >= x1) || (y0 >= y1))
     {
-        yStart = -y;
-        y = 0;
+        return false;
     }
 
-    if ((y - yStart + image.getHeight()) >
-        static_cast<int32_t>(m_vinfo.yres))
+    // Source positions are 16.16 fixed point, sampled at the centre of
+    // each destination pixel. Bilinear filtering interpolates between the
+    // source pixels either side, so is offset by half a source pixel.
+
+    int32_t stepX = (static_cast<int64_t>(imageWidth) << 16) / width;
+    int32_t stepY = (static_cast<int64_t>(imageHeight) << 16) / height;
+    int32_t offset = (filter == ScaleFilter::BILINEAR) ? 0x8000 : 0;
+
+    int32_t length = x1 - x0;
+    int32_t x = ((x0 - p.x()) * stepX) + (stepX / 2) - offset;
+
+    std::vector<uint16_t> row(length);
+    std::vector<uint16_t> blended;
+
+    if (filter == ScaleFilter::BILINEAR)
     {
-        yEnd = m_vinfo.yres - 1 - (y - yStart);
+        blended.resize(imageWidth);
     }
 
-    if ((xEnd - xStart) <= 0)
+    for (int32_t j = y0 ; j < y1 ; ++j)
     {
-        return false;
+        int32_t y = ((j - p.y()) * stepY) + (stepY / 2) - offset;
+        int32_t sy = std::min(std::max(y >> 16, 0), imageHeight - 1);
+
+        if (filter == ScaleFilter::NEAREST)
+        {
+            scaleRowNearest(row.data(),
+                            length,
+                            image.getRow(sy),
+                            imageWidth,
+                            x,
+                            stepX);
+        }
+        else
+        {
+            auto src = image.getRow(sy);
+
+            if ((y > 0) && (sy < (imageHeight - 1)) && ((y & 0xF800) != 0))
+            {
+                lerpRow(blended.data(),
+                        src,
+                        image.getRow(sy + 1),
+                        imageWidth,
+                        (y >> 11) & 0x1F);
+
+                src = blended.data();
+            }
+
+            scaleRowBilinear(row.data(),
+                             length,
+                             src,
+                             imageWidth,
+                             x,
+                             stepX);
+        }
+
+        m_bytesWritten += drawSpan(x0, j, row.data(), length);
     }
 
-    if ((yEnd - yStart) <= 0)
+    timer.count(length * (y1 - y0), m_bytesWritten);
+
+    return true;
+}
+
+//-------------------------------------------------------------------------
+
+bool
+raspifb16::FrameBuffer565:: blendImage(
+    const FB565Point& p,
+    const Image565Alpha& image) const
+{
+    m_bytesWritten = 0;
+
+    int32_t x0 = std::max(p.x(), 0);
+    int32_t x1 = std::min(p.x() + image.getWidth(), getWidth());
+    int32_t y0 = std::max(p.y(), 0);
+    int32_t y1 = std::min(p.y() + image.getHeight(), getHeight());
+
+    if ((x0 >= x1) || (y0 >= y1))
     {
         return false;
     }
 
-    for (auto j = yStart ; j <= yEnd ; ++j)
+    // Transparent runs are skipped and opaque runs are written directly,
+    // only translucent runs need to read back what is underneath.
+
+    std::vector<uint16_t> row(x1 - x0);
+
+    for (int32_t j = y0 ; j < y1 ; ++j)
     {
-        auto start = image.getRow(j) + xStart;
+        int16_t sy = j - p.y();
+        auto src = image.getRow(sy) + (x0 - p.x());
+        auto alpha = image.getAlphaRow(sy) + (x0 - p.x());
 
-        std::copy(start,
-                  start + (xEnd - xStart + 1),
-                  m_fbp + ((j+y) * m_lineLengthPixels) + x);
+        for (int32_t i = 0 ; i < (x1 - x0) ; )
+        {
+            int32_t run = 0;
+
+            switch (alphaRun(alpha + i, x1 - x0 - i, run))
+            {
+            case AlphaRun::TRANSPARENT:
+
+                break;
+
+            case AlphaRun::OPAQUE:
+
+                m_bytesWritten += drawSpan(x0 + i, j, src + i, run);
+
+                break;
+
+            case AlphaRun::TRANSLUCENT:
+
+                readSpan(x0 + i, j, row.data(), run);
+                blendRow(row.data(), src + i, alpha + i, run);
+                m_bytesWritten += drawSpan(x0 + i, j, row.data(), run);
+
+                break;
+            }
+
+            i += run;
+        }
     }
 
     return true;
 }
 
+//-------------------------------------------------------------------------
+
+raspifb16::Image565
+raspifb16::FrameBuffer565:: snapshot() const
+{
+    Image565 image(getWidth(), getHeight());
+    snapshot(image);
+
+    return image;
+}
+
+//-------------------------------------------------------------------------
+
+bool
+raspifb16::FrameBuffer565:: snapshot(
+    Image565& image) const
+{
+    if ((image.getWidth() != getWidth()) || (image.getHeight() != getHeight()))
+    {
+        return false;
+    }
+
+    // The visible rows, rather than those being drawn (which differ when
+    // double buffered).
+
+    for (int32_t j = 0 ; j < getHeight() ; ++j)
+    {
+        auto row = visibleRow() + j;
+        auto dst = image.getRow(j);
+
+        if (m_shadowEnabled)
+        {
+            auto src = m_shadow.data() + (row * m_vinfo.xres);
+            std::copy(src, src + m_vinfo.xres, dst);
+        }
+        else
+        {
+            m_kernels->m_readRow(dst, rowAddress(row, 0), m_vinfo.xres);
+        }
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------
+
+bool
+raspifb16::FrameBuffer565:: scroll(
+    const FB565Rectangle& rectangle,
+    int32_t dx,
+    int32_t dy,
+    uint16_t rgb) const
+{
+    m_bytesWritten = 0;
+
+    auto area = rectangle.intersection(
+        FB565Rectangle(0, 0, getWidth(), getHeight()));
+
+    if (area.empty())
+    {
+        return false;
+    }
+
+    // The part of the area that is still inside it once moved, relative
+    // to the top left corner of the area.
+
+    BlitRegion region{0, 0, dx, dy, area.width(), area.height()};
+
+    if (!clipBlit(region,
+                  area.width(),
+                  area.height(),
+                  area.width(),
+                  area.height()))
+    {
+        region.m_width = 0;
+        region.m_height = 0;
+    }
+
+    for (int32_t i = 0 ; i < area.height() ; ++i)
+    {
+        // Work from the bottom up when moving down, so rows are read
+        // before they are overwritten.
+
+        int32_t j = (dy > 0) ? (area.height() - 1 - i) : i;
+        int32_t y = area.y() + j;
+
+        if ((j < region.m_dstY) || (j >= region.m_dstY + region.m_height))
+        {
+            m_bytesWritten += fillSpan(area.x(), y, rgb, area.width());
+            continue;
+        }
+
+        m_bytesWritten += moveSpan(area.x() + region.m_dstX,
+                                   y,
+                                   area.x() + region.m_srcX,
+                                   y - dy,
+                                   region.m_width);
+
+        if (region.m_dstX > 0)
+        {
+            m_bytesWritten += fillSpan(area.x(), y, rgb, region.m_dstX);
+        }
+        else if (region.m_width < area.width())
+        {
+            m_bytesWritten += fillSpan(area.x() + region.m_width,
+                                       y,
+                                       rgb,
+                                       area.width() - region.m_width);
+        }
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------
+
+raspifb16::Image565View
+raspifb16::FrameBuffer565:: getView(
+    const FB565Rectangle& rectangle) const
+{
+    auto area = rectangle.intersection(
+        FB565Rectangle(0, 0, getWidth(), getHeight()));
+
+    if (area.empty())
+    {
+        return Image565View{};
+    }
+
+    if (!m_backBuffer.empty())
+    {
+        return Image565View{m_backBuffer.data()
+                            + (area.y() * m_vinfo.xres)
+                            + area.x(),
+                            static_cast<int16_t>(area.width()),
+                            static_cast<int16_t>(area.height()),
+                            static_cast<int32_t>(m_vinfo.xres)};
+    }
+
+    if ((m_kernels->m_format != PixelFormat::RGB565) || m_shadowEnabled)
+    {
+        return Image565View{};
+    }
+
+    auto bytesPerRow = area.width() * m_kernels->m_bytesPerPixel;
+
+    for (int32_t j = area.y() ; j < area.bottom() ; ++j)
+    {
+        markDirty(rowAddress(m_drawRow + j, area.x()), bytesPerRow);
+    }
+
+    auto pixels = rowAddress(m_drawRow + area.y(), area.x());
+
+    return Image565View{reinterpret_cast<uint16_t*>(pixels),
+                        static_cast<int16_t>(area.width()),
+                        static_cast<int16_t>(area.height()),
+                        static_cast<int32_t>(m_finfo.line_length / 2)};
+}
+
+//-------------------------------------------------------------------------
+
+bool
+raspifb16::FrameBuffer565:: putSprite(
+    const FB565Point& p,
+    const Sprite565& sprite) const
+{
+    m_bytesWritten = 0;
+
+    int32_t x0 = std::max(p.x(), 0);
+    int32_t x1 = std::min(p.x() + sprite.getWidth(), getWidth());
+    int32_t y0 = std::max(p.y(), 0);
+    int32_t y1 = std::min(p.y() + sprite.getHeight(), getHeight());
+
+    if ((x0 >= x1) || (y0 >= y1))
+    {
+        return false;
+    }
+
+    for (int32_t j = y0 ; j < y1 ; ++j)
+    {
+        int16_t sy = j - p.y();
+        auto src = sprite.getRow(sy);
+        auto spans = sprite.getSpans(sy);
+
+        for (auto span = spans.first ; span != spans.second ; ++span)
+        {
+            int32_t start = std::max(span->m_x + p.x(), x0);
+            int32_t end = std::min(span->m_x + span->m_length + p.x(), x1);
+
+            if (start < end)
+            {
+                m_bytesWritten += drawSpan(start,
+                                           j,
+                                           src + (start - p.x()),
+                                           end - start);
+            }
+        }
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------
+
+bool
+raspifb16::FrameBuffer565:: putImage(
+    const FB565Point& p,
+    const Rle565& rle) const
+{
+    m_bytesWritten = 0;
+    CallTimer timer{m_putImageCounter};
+
+    int32_t x0 = std::max(p.x(), 0);
+    int32_t x1 = std::min(p.x() + rle.getWidth(), getWidth());
+    int32_t y0 = std::max(p.y(), 0);
+    int32_t y1 = std::min(p.y() + rle.getHeight(), getHeight());
+
+    if ((x0 >= x1) || (y0 >= y1))
+    {
+        return false;
+    }
+
+    int32_t dx = p.x();
+
+    for (int32_t j = y0 ; j < y1 ; ++j)
+    {
+        rle.forEachRun(j - p.y(),
+                       x0 - dx,
+                       x1 - dx,
+                       [this, j, dx](int32_t x, int32_t length, uint16_t rgb)
+                       {
+                           m_bytesWritten += fillSpan(x + dx, j, rgb, length);
+                       },
+                       [this, j, dx](int32_t x,
+                                     const uint16_t* pixels,
+                                     int32_t length)
+                       {
+                           m_bytesWritten += drawSpan(x + dx,
+                                                      j,
+                                                      pixels,
+                                                      length);
+                       });
+    }
+
+    timer.count((x1 - x0) * (y1 - y0), m_bytesWritten);
+
+    return true;
+}
+
+//-------------------------------------------------------------------------
+
+bool
+raspifb16::FrameBuffer565:: putImage(
+    const FB565Point& p,
+    const MappedImage565& image) const
+{
+    if (image.getRle())
+    {
+        return putImage(p, *image.getRle());
+    }
+
+    m_bytesWritten = 0;
+    CallTimer timer{m_putImageCounter};
+
+    BlitRegion region{0, 0, p.x(), p.y(), image.getWidth(), image.getHeight()};
+
+    if (!clipBlit(region,
+                  image.getWidth(),
+                  image.getHeight(),
+                  getWidth(),
+                  getHeight()))
+    {
+        return false;
+    }
+
+    for (int32_t j = 0 ; j < region.m_height ; ++j)
+    {
+        m_bytesWritten += drawSpan(region.m_dstX,
+                                   region.m_dstY + j,
+                                   image.getRow(region.m_srcY + j)
+                                   + region.m_srcX,
+                                   region.m_width);
+    }
+
+    timer.count(region.m_width * region.m_height, m_bytesWritten);
+
+    return true;
+}
+
+//-------------------------------------------------------------------------
+
+bool
+raspifb16::FrameBuffer565:: present()
+{
+    auto start = std::chrono::steady_clock::now();
+
+    if (m_vsyncEnabled)
+    {
+        waitForFrame();
+    }
+
+    std::chrono::steady_clock::time_point shown;
+    bool result = swapBuffers(shown);
+
+    if (m_flushMode == FlushMode::ON_PRESENT)
+    {
+        flush();
+    }
+
+    recordPresent(start, shown);
+
+    return result;
+}
+
+//-------------------------------------------------------------------------
+
+bool
+raspifb16::FrameBuffer565:: swapBuffers(
+    std::chrono::steady_clock::time_point& shown)
+{
+    m_bytesWritten = 0;
+    shown = std::chrono::steady_clock::now();
+
+    if (m_buffering == Buffering::SINGLE)
+    {
+        return true;
+    }
+
+    if (m_pageFlipping)
+    {
+        struct fb_var_screeninfo vinfo = m_vinfo;
+        vinfo.yoffset = m_drawRow;
+
+        if (ioctl(m_fbfd.fd(), FBIOPAN_DISPLAY, &vinfo) != -1)
+        {
+            shown = std::chrono::steady_clock::now();
+            m_drawRow = visibleRow();
+            m_vinfo.yoffset = vinfo.yoffset;
+
+            return true;
+        }
+
+        // The driver refused to pan, so keep drawing off screen and copy
+        // each frame instead.
+
+        m_pageFlipping = false;
+        createBackBuffer(m_drawRow);
+    }
+
+    for (uint32_t j = 0 ; j < m_vinfo.yres ; ++j)
+    {
+        m_bytesWritten += writeDevice(visibleRow() + j,
+                                      0,
+                                      m_backBuffer.data() + (j * m_vinfo.xres),
+                                      m_vinfo.xres);
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------
+
+size_t
+raspifb16::FrameBuffer565:: flush(
+    bool synchronous) const
+{
+    CallTimer timer{m_flushCounter};
+
+    auto flushed = flushPages(0,
+                              m_dirtyPages.size(),
+                              (synchronous) ? MS_SYNC : MS_ASYNC);
+
+    timer.count(getWidth() * getHeight(), flushed * m_pageSize);
+
+    return flushed;
+}
+
+//-------------------------------------------------------------------------
+
+size_t
+raspifb16::FrameBuffer565:: flush(
+    const FB565Rectangle& rectangle,
+    bool synchronous) const
+{
+    auto area = rectangle.intersection(
+        FB565Rectangle(0, 0, getWidth(), getHeight()));
+
+    if (area.empty())
+    {
+        return 0;
+    }
+
+    CallTimer timer{m_flushCounter};
+
+    int flags = (synchronous) ? MS_SYNC : MS_ASYNC;
+    size_t flushed{0};
+
+    // Pages touched by consecutive rows are merged into one range, so a
+    // narrow rectangle does not need an msync per row.
+
+    size_t first{0};
+    size_t last{0};
+
+    for (int32_t j = area.y() ; j < area.bottom() ; ++j)
+    {
+        auto row = m_drawRow + j;
+        size_t start = (rowAddress(row, area.x()) - m_fbp) / m_pageSize;
+        size_t end = ((rowAddress(row, area.right()) - m_fbp) - 1)
+                   / m_pageSize + 1;
+
+        if (start > last)
+        {
+            flushed += flushPages(first, last, flags);
+            first = start;
+        }
+
+        last = end;
+    }
+
+    flushed += flushPages(first, last, flags);
+
+    timer.count(area.width() * area.height(), flushed * m_pageSize);
+
+    return flushed;
+}
+
+//-------------------------------------------------------------------------
+
+size_t
+raspifb16::FrameBuffer565:: getDirtyPages() const
+{
+    return std::count(m_dirtyPages.begin(), m_dirtyPages.end(), true);
+}
+
+//-------------------------------------------------------------------------
+
+raspifb16::DrawStatistics
+raspifb16::FrameBuffer565:: getDrawStatistics() const
+{
+    return DrawStatistics{m_putImageCounter.snapshot(),
+                          m_clearCounter.snapshot(),
+                          m_flushCounter.snapshot()};
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::FrameBuffer565:: resetDrawStatistics()
+{
+    m_putImageCounter.reset();
+    m_clearCounter.reset();
+    m_flushCounter.reset();
+}
+
+//-------------------------------------------------------------------------
+
+bool
+raspifb16::FrameBuffer565:: waitForVsync() const
+{
+    if (!m_isDevice)
+    {
+        return false;
+    }
+
+    uint32_t crtc{0};
+
+    return ioctl(m_fbfd.fd(), FBIO_WAITFORVSYNC, &crtc) != -1;
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::FrameBuffer565:: waitForFrame()
+{
+    if (m_vsyncSupported)
+    {
+        m_vsyncSupported = waitForVsync();
+
+        if (m_vsyncSupported)
+        {
+            return;
+        }
+    }
+
+    // No vertical blank interrupt, so wait until the start of the next
+    // frame period instead.
+
+    auto now = std::chrono::steady_clock::now();
+    auto frames = (now - m_pacerOrigin) / m_framePeriod;
+
+    std::this_thread::sleep_until(m_pacerOrigin
+                                  + ((frames + 1) * m_framePeriod));
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::FrameBuffer565:: recordPresent(
+    std::chrono::steady_clock::time_point start,
+    std::chrono::steady_clock::time_point shown)
+{
+    auto end = std::chrono::steady_clock::now();
+    auto latency = end - start;
+    auto& statistics = m_presentStatistics;
+
+    ++statistics.m_frames;
+    statistics.m_lastLatency = latency;
+    statistics.m_minLatency = std::min(statistics.m_minLatency,
+                                       statistics.m_lastLatency);
+    statistics.m_maxLatency = std::max(statistics.m_maxLatency,
+                                       statistics.m_lastLatency);
+    statistics.m_totalLatency += latency;
+    statistics.m_totalCopyTime += end - shown;
+
+    // Waiting for the vertical blank and flipping should take no more
+    // than one frame period (allowing half a period for waking late),
+    // any longer and a blank was missed. Copying to a slow panel
+    // afterwards does not delay the frame being shown.
+
+    if (m_vsyncEnabled)
+    {
+        statistics.m_missedVsyncs += (shown - start - (m_framePeriod / 2))
+                                   / m_framePeriod;
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::FrameBuffer565:: setShadowEnabled(
+    bool enabled)
+{
+    m_shadowEnabled = enabled;
+
+    if (m_shadowEnabled)
+    {
+        m_shadow.resize(memoryRows() * m_vinfo.xres);
+
+        for (int32_t row = 0 ; row < memoryRows() ; ++row)
+        {
+            m_kernels->m_readRow(m_shadow.data() + (row * m_vinfo.xres),
+                                 rowAddress(row, 0),
+                                 m_vinfo.xres);
+        }
+    }
+    else
+    {
+        m_shadow.clear();
+        m_shadow.shrink_to_fit();
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::FrameBuffer565:: createBackBuffer(
+    int32_t row)
+{
+    m_backBuffer.resize(m_vinfo.xres * m_vinfo.yres);
+
+    for (uint32_t j = 0 ; j < m_vinfo.yres ; ++j)
+    {
+        m_kernels->m_readRow(m_backBuffer.data() + (j * m_vinfo.xres),
+                             rowAddress(row + j, 0),
+                             m_vinfo.xres);
+    }
+}
+
+//-------------------------------------------------------------------------
+
+size_t
+raspifb16::FrameBuffer565:: drawSpan(
+    int32_t x,
+    int32_t y,
+    const uint16_t* src,
+    int32_t length) const
+{
+    if (m_backBuffer.empty())
+    {
+        return writeDevice(m_drawRow + y, x, src, length);
+    }
+
+    std::copy(src, src + length, m_backBuffer.data() + (y * m_vinfo.xres) + x);
+
+    return 0;
+}
+
+//-------------------------------------------------------------------------
+
+size_t
+raspifb16::FrameBuffer565:: moveSpan(
+    int32_t dstX,
+    int32_t dstY,
+    int32_t srcX,
+    int32_t srcY,
+    int32_t length) const
+{
+    if (!m_backBuffer.empty())
+    {
+        auto buffer = m_backBuffer.data();
+        memmove(buffer + (dstY * m_vinfo.xres) + dstX,
+                buffer + (srcY * m_vinfo.xres) + srcX,
+                length * sizeof(uint16_t));
+
+        return 0;
+    }
+
+    // The pixels are already in device format, so they can be moved as
+    // bytes without a conversion in either direction.
+
+    auto dst = rowAddress(m_drawRow + dstY, dstX);
+    auto bytes = length * m_kernels->m_bytesPerPixel;
+
+    memmove(dst, rowAddress(m_drawRow + srcY, srcX), bytes);
+    markDirty(dst, bytes);
+
+    if (m_shadowEnabled)
+    {
+        auto shadow = m_shadow.data();
+        memmove(shadow + ((m_drawRow + dstY) * m_vinfo.xres) + dstX,
+                shadow + ((m_drawRow + srcY) * m_vinfo.xres) + srcX,
+                length * sizeof(uint16_t));
+    }
+
+    return bytes;
+}
+
+//-------------------------------------------------------------------------
+
+size_t
+raspifb16::FrameBuffer565:: fillSpan(
+    int32_t x,
+    int32_t y,
+    uint16_t rgb,
+    int32_t length) const
+{
+    if (m_backBuffer.empty())
+    {
+        return fillDevice(m_drawRow + y, x, rgb, length);
+    }
+
+    std::fill_n(m_backBuffer.data() + (y * m_vinfo.xres) + x, length, rgb);
+
+    return 0;
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::FrameBuffer565:: readSpan(
+    int32_t x,
+    int32_t y,
+    uint16_t* dst,
+    int32_t length) const
+{
+    if (!m_backBuffer.empty())
+    {
+        auto src = m_backBuffer.data() + (y * m_vinfo.xres) + x;
+        std::copy(src, src + length, dst);
+    }
+    else if (m_shadowEnabled)
+    {
+        auto src = m_shadow.data() + ((m_drawRow + y) * m_vinfo.xres) + x;
+        std::copy(src, src + length, dst);
+    }
+    else
+    {
+        m_kernels->m_readRow(dst, rowAddress(m_drawRow + y, x), length);
+    }
+}
+
+//-------------------------------------------------------------------------
+
+size_t
+raspifb16::FrameBuffer565:: writeDevice(
+    int32_t row,
+    int32_t x,
+    const uint16_t* src,
+    int32_t length) const
+{
+    auto dst = rowAddress(row, x);
+    auto bytesPerPixel = m_kernels->m_bytesPerPixel;
+
+    if (!m_shadowEnabled)
+    {
+        m_kernels->m_writeRow(dst, src, length);
+        markDirty(dst, length * bytesPerPixel);
+
+        return length * bytesPerPixel;
+    }
+
+    auto shadow = m_shadow.data() + (row * m_vinfo.xres) + x;
+    size_t written{0};
+    int32_t i{0};
+
+    while (i < length)
+    {
+        while ((i < length) && (src[i] == shadow[i]))
+        {
+            ++i;
+        }
+
+        auto start = i;
+
+        while ((i < length) && (src[i] != shadow[i]))
+        {
+            ++i;
+        }
+
+        m_kernels->m_writeRow(dst + (start * bytesPerPixel),
+                              src + start,
+                              i - start);
+        markDirty(dst + (start * bytesPerPixel), (i - start) * bytesPerPixel);
+        std::copy(src + start, src + i, shadow + start);
+
+        written += (i - start) * bytesPerPixel;
+    }
+
+    return written;
+}
+
+//-------------------------------------------------------------------------
+
+size_t
+raspifb16::FrameBuffer565:: fillDevice(
+    int32_t row,
+    int32_t x,
+    uint16_t rgb,
+    int32_t length) const
+{
+    auto dst = rowAddress(row, x);
+    auto bytesPerPixel = m_kernels->m_bytesPerPixel;
+
+    if (!m_shadowEnabled)
+    {
+        m_kernels->m_fillRow(dst, rgb, length);
+        markDirty(dst, length * bytesPerPixel);
+
+        return length * bytesPerPixel;
+    }
+
+    auto shadow = m_shadow.data() + (row * m_vinfo.xres) + x;
+    size_t written{0};
+    int32_t i{0};
+
+    while (i < length)
+    {
+        while ((i < length) && (shadow[i] == rgb))
+        {
+            ++i;
+        }
+
+        auto start = i;
+
+        while ((i < length) && (shadow[i] != rgb))
+        {
+            ++i;
+        }
+
+        m_kernels->m_fillRow(dst + (start * bytesPerPixel), rgb, i - start);
+        markDirty(dst + (start * bytesPerPixel), (i - start) * bytesPerPixel);
+        std::fill(shadow + start, shadow + i, rgb);
+
+        written += (i - start) * bytesPerPixel;
+    }
+
+    return written;
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::FrameBuffer565:: markDirty(
+    const uint8_t* address,
+    size_t length) const
+{
+    if (length == 0)
+    {
+        return;
+    }
+
+    size_t first = (address - m_fbp) / m_pageSize;
+    size_t last = (address - m_fbp + length - 1) / m_pageSize;
+
+    for (size_t page = first ; page <= last ; ++page)
+    {
+        m_dirtyPages[page] = true;
+    }
+}
+
+//-------------------------------------------------------------------------
+
+size_t
+raspifb16::FrameBuffer565:: flushPages(
+    size_t first,
+    size_t last,
+    int flags) const
+{
+    last = std::min(last, m_dirtyPages.size());
+
+    size_t flushed{0};
+    size_t page{first};
+
+    while (page < last)
+    {
+        while ((page < last) && !m_dirtyPages[page])
+        {
+            ++page;
+        }
+
+        auto start = page;
+
+        while ((page < last) && m_dirtyPages[page])
+        {
+            m_dirtyPages[page] = false;
+            ++page;
+        }
+
+        if ((page > start) &&
+            (::msync(m_fbp + (start * m_pageSize),
+                     (page - start) * m_pageSize,
+                     flags) != -1))
+        {
+            flushed += page - start;
+        }
+    }
+
+    return flushed;
+}
@@ -30,15 +30,23 @@
 
 //-------------------------------------------------------------------------
 
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <linux/fb.h>
 
+#include "callStatistics.h"
 #include "fileDescriptor.h"
+#include "image565View.h"
+#include "pixelFormat.h"
 #include "point.h"
+#include "rectangle.h"
 #include "rgb565.h"
+#include "scale565.h"
 
 //-------------------------------------------------------------------------
 
@@ -48,10 +56,50 @@ namespace raspifb16
 //-------------------------------------------------------------------------
 
 using FB565Point = Point<int32_t>;
+using FB565Rectangle = Rectangle<int32_t>;
 
 //-------------------------------------------------------------------------
 
 class Image565;
+class Image565Alpha;
+class MappedImage565;
+class Rle565;
+class Sprite565;
+
+//-------------------------------------------------------------------------
+
+// Clockwise rotation.
+
+enum class Rotation { ROTATE_0, ROTATE_90, ROTATE_180, ROTATE_270 };
+
+//-------------------------------------------------------------------------
+
+// Latency is the whole of present(). Missed vsyncs are counted from the
+// wait for the vertical blank and the page flip only, the time spent
+// copying the back buffer and flushing is counted in m_totalCopyTime.
+
+struct PresentStatistics
+{
+    uint64_t m_frames;
+    uint64_t m_missedVsyncs;
+    std::chrono::nanoseconds m_lastLatency;
+    std::chrono::nanoseconds m_minLatency;
+    std::chrono::nanoseconds m_maxLatency;
+    std::chrono::nanoseconds m_totalLatency;
+    std::chrono::nanoseconds m_totalCopyTime;
+};
+
+//-------------------------------------------------------------------------
+
+// Counted when the library is built with RASPIFB16_STATISTICS. Bytes are
+// those written to the device (or flushed, for m_flush).
+
+struct DrawStatistics
+{
+    CallStatistics m_putImage;
+    CallStatistics m_clear;
+    CallStatistics m_flush;
+};
 
 //-------------------------------------------------------------------------
 
@@ -59,9 +107,20 @@ class FrameBuffer565
 {
 public:
 
-    static constexpr size_t bytesPerPixel{2};
+    enum class Buffering { SINGLE, DOUBLE };
+    enum class FlushMode { NONE, ON_PRESENT };
 
-    explicit FrameBuffer565(const std::string& device);
+    // device is either a framebuffer device such as /dev/fb1, or a memory
+    // surface "mem:<width>x<height>[x<bpp>][:<stride>]", or a file backed
+    // surface "file:<path>:<width>x<height>[x<bpp>][:<stride>]" (bpp is
+    // 16, 24 or 32 and stride is in pixels).
+    //
+    // The framebuffer may be any of the formats in PixelFormat, images
+    // are converted from RGB565 as they are written.
+
+    explicit FrameBuffer565(
+        const std::string& device,
+        Buffering buffering = Buffering::SINGLE);
 
     ~FrameBuffer565();
 
@@ -74,6 +133,9 @@ public:
     int32_t getWidth() const { return m_vinfo.xres; }
     int32_t getHeight() const { return m_vinfo.yres; }
 
+    PixelFormat getPixelFormat() const { return m_kernels->m_format; }
+    size_t getBytesPerPixel() const { return m_kernels->m_bytesPerPixel; }
+
     bool hideCursor();
 
     void clear(const RGB565& rgb) const { clear(rgb.get565()); }
@@ -94,12 +156,157 @@ public:
 
     bool putImage(const FB565Point& p, const Image565& image) const;
 
-private:
+    // Copy just the given rectangle of the image, with its top left
+    // corner at p.
 
     bool
-    putImagePartial(
+    putImage(
         const FB565Point& p,
-        const Image565& image) const;
+        const Image565& image,
+        const Rectangle<int16_t>& rectangle) const;
+
+    // Copy a rectangle of the framebuffer into image at p.
+
+    bool
+    getImage(
+        const FB565Rectangle& rectangle,
+        Image565& image,
+        const Point<int16_t>& p) const;
+
+    // The top left corner of the rotated image is placed at p.
+
+    bool
+    putImage(
+        const FB565Point& p,
+        const Image565& image,
+        Rotation rotation) const;
+
+    // Scale the image to width x height with its top left corner at p.
+
+    bool
+    putImage(
+        const FB565Point& p,
+        const Image565& image,
+        int32_t width,
+        int32_t height,
+        ScaleFilter filter = ScaleFilter::BILINEAR) const;
+
+    // Blend the image over the framebuffer using its alpha plane.
+
+    bool blendImage(const FB565Point& p, const Image565Alpha& image) const;
+
+    // Copy what is currently on screen. The image passed in must be the
+    // same size as the framebuffer.
+
+    Image565 snapshot() const;
+    bool snapshot(Image565& image) const;
+
+    // Move the pixels in the rectangle by dx, dy and fill the area
+    // uncovered with rgb. The copy is done in place, in the back buffer
+    // if there is one, otherwise directly in framebuffer memory.
+
+    bool
+    scroll(
+        const FB565Rectangle& rectangle,
+        int32_t dx,
+        int32_t dy,
+        uint16_t rgb = 0) const;
+
+    // A view for drawing straight into the part of the framebuffer inside
+    // the rectangle: the back buffer if there is one, otherwise the
+    // framebuffer memory itself. The view is empty if the framebuffer is
+    // not RGB565 or the shadow is enabled, as the pixels written through
+    // it are not converted or tracked. The pages it covers are marked as
+    // dirty when the view is made, as writes through it cannot be seen,
+    // so flush() syncs them only once. Get a fresh view for drawing after
+    // each flush(), or those pages are not synced again. With page
+    // flipping the view is only valid until the next present().
+
+    Image565View getView(const FB565Rectangle& rectangle) const;
+
+    Image565View
+    getView() const
+    {
+        return getView(FB565Rectangle(0, 0, getWidth(), getHeight()));
+    }
+
+    // Draw only the opaque (not key colour) pixels of the sprite.
+
+    bool putSprite(const FB565Point& p, const Sprite565& sprite) const;
+
+    // Draw a run length encoded image, filling and copying each run
+    // straight into the framebuffer.
+
+    bool putImage(const FB565Point& p, const Rle565& rle) const;
+
+    // Draw a .i565 image, raw or run length encoded.
+
+    bool putImage(const FB565Point& p, const MappedImage565& image) const;
+
+    // When double buffered, drawing goes to a hidden buffer that is made
+    // visible by present(). Page flipping leaves the frame before last in
+    // the hidden buffer, so each frame should be drawn in full.
+
+    bool present();
+
+    bool isPageFlipping() const { return m_pageFlipping; }
+
+    bool isDevice() const { return m_isDevice; }
+
+    // With a shadow copy of the framebuffer memory, only pixels that
+    // differ from what is already there are written to the device.
+
+    void setShadowEnabled(bool enabled);
+    bool isShadowEnabled() const { return m_shadowEnabled; }
+
+    // Bytes written to device memory by the last call to clear(),
+    // putImage() or present().
+
+    size_t getBytesWritten() const { return m_bytesWritten; }
+
+    // Returns false if the driver does not support FBIO_WAITFORVSYNC.
+
+    bool waitForVsync() const;
+
+    // With vsync enabled, present() waits for the vertical blank before
+    // showing the frame. Drivers without FBIO_WAITFORVSYNC are paced
+    // using the refresh period calculated from the display timings.
+
+    void setVsyncEnabled(bool enabled) { m_vsyncEnabled = enabled; }
+    bool isVsyncEnabled() const { return m_vsyncEnabled; }
+
+    std::chrono::nanoseconds getFramePeriod() const { return m_framePeriod; }
+
+    // Drivers with deferred I/O (such as fbtft) push the pages that have
+    // been touched to the display on a timer. flush() pushes the pages
+    // written since the last flush straight away (msync with MS_SYNC, or
+    // MS_ASYNC if not synchronous) and returns the number of pages
+    // flushed. With FlushMode::ON_PRESENT, present() flushes so all the
+    // writes of a frame go out together. A rectangle is flushed from the
+    // page being drawn, so flush it before present() when page flipping.
+
+    size_t flush(bool synchronous = true) const;
+
+    size_t
+    flush(
+        const FB565Rectangle& rectangle,
+        bool synchronous = true) const;
+
+    void setFlushMode(FlushMode mode) { m_flushMode = mode; }
+    FlushMode getFlushMode() const { return m_flushMode; }
+
+    size_t getDirtyPages() const;
+
+    const PresentStatistics&
+    getPresentStatistics() const
+    {
+        return m_presentStatistics;
+    }
+
+    DrawStatistics getDrawStatistics() const;
+    void resetDrawStatistics();
+
+private:
 
     bool
     validPixel(const FB565Point& p) const
@@ -110,14 +317,118 @@ private:
                (p.y() < static_cast<int32_t>(m_vinfo.yres));
     }
 
+    void openDevice(const std::string& device);
+    bool openSurface(const std::string& device);
+    bool setupPageFlipping();
+    bool swapBuffers(std::chrono::steady_clock::time_point& shown);
+    void waitForFrame();
+
+    void
+    recordPresent(
+        std::chrono::steady_clock::time_point start,
+        std::chrono::steady_clock::time_point shown);
+
+    size_t
+    drawSpan(
+        int32_t x,
+        int32_t y,
+        const uint16_t* src,
+        int32_t length) const;
+
+    void
+    readSpan(
+        int32_t x,
+        int32_t y,
+        uint16_t* dst,
+        int32_t length) const;
+
+    size_t
+    moveSpan(
+        int32_t dstX,
+        int32_t dstY,
+        int32_t srcX,
+        int32_t srcY,
+        int32_t length) const;
+
+    size_t
+    fillSpan(
+        int32_t x,
+        int32_t y,
+        uint16_t rgb,
+        int32_t length) const;
+
+    size_t
+    writeDevice(
+        int32_t row,
+        int32_t x,
+        const uint16_t* src,
+        int32_t length) const;
+
+    size_t
+    fillDevice(
+        int32_t row,
+        int32_t x,
+        uint16_t rgb,
+        int32_t length) const;
+
+    void createBackBuffer(int32_t row);
+
+    void markDirty(const uint8_t* address, size_t length) const;
+    size_t flushPages(size_t first, size_t last, int flags) const;
+
+    uint8_t*
+    rowAddress(
+        int32_t row,
+        int32_t x) const
+    {
+        return m_fbp
+             + (row * m_finfo.line_length)
+             + (x * m_kernels->m_bytesPerPixel);
+    }
+
+    int32_t visibleRow() const { return m_vinfo.yoffset; }
+
+    int32_t
+    memoryRows() const
+    {
+        return std::min(m_vinfo.yres_virtual,
+                        m_finfo.smem_len / m_finfo.line_length);
+    }
+
+    FileDescriptor m_fbfd;
     FileDescriptor m_consolefd;
 
     struct fb_fix_screeninfo m_finfo;
     struct fb_var_screeninfo m_vinfo;
+    struct fb_var_screeninfo m_vinfoOriginal;
+
+    const PixelKernels* m_kernels;
+
+    bool m_isDevice;
+    Buffering m_buffering;
+    bool m_pageFlipping;
+
+    uint8_t* m_fbp;
+    int32_t m_drawRow;
+    mutable std::vector<uint16_t> m_backBuffer;
+
+    bool m_shadowEnabled;
+    mutable std::vector<uint16_t> m_shadow;
+    mutable size_t m_bytesWritten;
+
+    bool m_vsyncEnabled;
+    bool m_vsyncSupported;
+    std::chrono::nanoseconds m_framePeriod;
+    std::chrono::steady_clock::time_point m_pacerOrigin;
+    PresentStatistics m_presentStatistics;
 
-    int32_t m_lineLengthPixels;
+    FlushMode m_flushMode;
+    size_t m_pageSize;
+    mutable std::vector<bool> m_dirtyPages;
 
-    uint16_t* m_fbp;
+    mutable CallCounter m_putImageCounter;
+    mutable CallCounter m_clearCounter;
+    mutable CallCounter m_flushCounter;
 };
 
 //-------------------------------------------------------------------------
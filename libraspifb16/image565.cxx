@@ -25,6 +25,10 @@
 //
 //-------------------------------------------------------------------------
 
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
 #include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -36,14 +40,90 @@
 
 using size_type = std::vector<uint16_t>::size_type;
 
+constexpr size_t raspifb16::Image565::sc_rowAlignment;
+
+//-------------------------------------------------------------------------
+
 raspifb16::Image565:: Image565(
     int16_t width,
-    int16_t height)
+    int16_t height,
+    Layout layout)
 :
     m_width{width},
     m_height{height},
-    m_buffer(width * height)
+    m_stride{width},
+    m_buffer()
+{
+    reshape(width, height, layout);
+}
+
+//-------------------------------------------------------------------------
+
+raspifb16::Image565:: Image565(
+    Image565&& image) noexcept
+:
+    m_width{image.m_width},
+    m_height{image.m_height},
+    m_stride{image.m_stride},
+    m_buffer(std::move(image.m_buffer))
+{
+    image.m_width = 0;
+    image.m_height = 0;
+    image.m_stride = 0;
+    image.m_buffer.clear();
+}
+
+//-------------------------------------------------------------------------
+
+raspifb16::Image565&
+raspifb16::Image565:: operator=(
+    Image565&& image) noexcept
+{
+    if (this != &image)
+    {
+        m_width = image.m_width;
+        m_height = image.m_height;
+        m_stride = image.m_stride;
+        m_buffer = std::move(image.m_buffer);
+
+        image.m_width = 0;
+        image.m_height = 0;
+        image.m_stride = 0;
+        image.m_buffer.clear();
+    }
+
+    return *this;
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::Image565:: reshape(
+    int16_t width,
+    int16_t height,
+    Layout layout)
 {
+    m_width = width;
+    m_height = height;
+    m_stride = stride(width, layout);
+    m_buffer.resize(m_stride * height);
+}
+
+//-------------------------------------------------------------------------
+
+int32_t
+raspifb16::Image565:: stride(
+    int16_t width,
+    Layout layout)
+{
+    if (layout == Layout::ALIGNED)
+    {
+        constexpr int32_t pixels = sc_rowAlignment / sizeof(uint16_t);
+
+        return ((width + pixels - 1) / pixels) * pixels;
+    }
+
+    return width;
 }
 
 //-------------------------------------------------------------------------
@@ -66,7 +146,7 @@ raspifb16::Image565:: setPixel(
 
     if (isValid)
     {
-        m_buffer[p.x() + (p.y() * m_width)] = rgb;
+        m_buffer[p.x() + (p.y() * m_stride)] = rgb;
     }
 
     return isValid;
@@ -83,7 +163,7 @@ raspifb16::Image565:: getPixelRGB(
 
     if (isValid)
     {
-        rgb.set565(m_buffer[p.x() + (p.y() * m_width)]);
+        rgb.set565(m_buffer[p.x() + (p.y() * m_stride)]);
     }
 
     return std::make_pair(isValid, rgb);
@@ -100,7 +180,7 @@ raspifb16::Image565:: getPixel(
 
     if (isValid)
     {
-        rgb = m_buffer[p.x() + (p.y() * m_width)];
+        rgb = m_buffer[p.x() + (p.y() * m_stride)];
     }
 
     return std::make_pair(isValid, rgb);
@@ -108,13 +188,29 @@ raspifb16::Image565:: getPixel(
 
 //-------------------------------------------------------------------------
 
+uint16_t*
+raspifb16::Image565:: getRow(
+    int16_t y)
+{
+    if (validPixel(Image565Point{0, y}))
+    {
+        return m_buffer.data() + (y * m_stride);
+    }
+    else
+    {
+        return nullptr;
+    }
+}
+
+//-------------------------------------------------------------------------
+
 const uint16_t*
 raspifb16::Image565:: getRow(
     int16_t y) const
 {
     if (validPixel(Image565Point{0, y}))
     {
-        return m_buffer.data() + (y * m_width);
+        return m_buffer.data() + (y * m_stride);
     }
     else
     {
@@ -122,3 +218,87 @@ raspifb16::Image565:: getRow(
     }
 }
 
+//-------------------------------------------------------------------------
+
+raspifb16::Image565Span
+raspifb16::Image565:: rowSpan(
+    int16_t y,
+    int16_t x0,
+    int16_t x1)
+{
+    if (x0 > x1)
+    {
+        std::swap(x0, x1);
+    }
+
+    x0 = std::max<int16_t>(x0, 0);
+    x1 = std::min<int16_t>(x1, m_width - 1);
+
+    if ((y < 0) || (y >= m_height) || (x0 > x1))
+    {
+        return Image565Span{nullptr, 0, 0};
+    }
+
+    return Image565Span{m_buffer.data() + (y * m_stride) + x0,
+                        x0,
+                        static_cast<int16_t>(x1 - x0 + 1)};
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::Image565:: scroll(
+    const Image565Rectangle& rectangle,
+    int16_t dx,
+    int16_t dy,
+    uint16_t rgb)
+{
+    auto area = rectangle.intersection(
+        Image565Rectangle(0, 0, m_width, m_height));
+
+    if (area.empty())
+    {
+        return;
+    }
+
+    int32_t width = area.width();
+    int32_t height = area.height();
+
+    // The part of each row that is still inside the rectangle once moved.
+
+    int32_t moveWidth = std::max(width - std::abs(dx), 0);
+
+    int32_t srcX = area.x() + std::max(-dx, 0);
+    int32_t dstX = area.x() + std::max<int32_t>(dx, 0);
+
+    for (int32_t i = 0 ; i < height ; ++i)
+    {
+        // Work from the bottom up when moving down, so rows are read
+        // before they are overwritten.
+
+        int32_t j = (dy > 0) ? (height - 1 - i) : i;
+        int32_t srcJ = j - dy;
+
+        auto row = m_buffer.data() + ((area.y() + j) * m_stride);
+
+        if ((moveWidth > 0) && (srcJ >= 0) && (srcJ < height))
+        {
+            auto src = m_buffer.data() + ((area.y() + srcJ) * m_stride);
+
+            memmove(row + dstX, src + srcX, moveWidth * sizeof(uint16_t));
+
+            if (dx > 0)
+            {
+                std::fill_n(row + area.x(), dstX - area.x(), rgb);
+            }
+            else
+            {
+                std::fill(row + dstX + moveWidth, row + area.right(), rgb);
+            }
+        }
+        else
+        {
+            std::fill(row + area.x(), row + area.right(), rgb);
+        }
+    }
+}
@@ -30,12 +30,15 @@
 
 //-------------------------------------------------------------------------
 
+#include <cstddef>
 #include <cstdint>
 #include <utility>
 #include <vector>
 
-#include "rgb565.h"
+#include "alignedAllocator.h"
 #include "point.h"
+#include "rectangle.h"
+#include "rgb565.h"
 
 //-------------------------------------------------------------------------
 
@@ -45,6 +48,18 @@ namespace raspifb16
 //-------------------------------------------------------------------------
 
 using Image565Point = Point<int16_t>;
+using Image565Rectangle = Rectangle<int16_t>;
+
+//-------------------------------------------------------------------------
+
+// A run of m_length pixels in one row of an image, starting at column m_x.
+
+struct Image565Span
+{
+    uint16_t* m_pixels;
+    int16_t m_x;
+    int16_t m_length;
+};
 
 //-------------------------------------------------------------------------
 
@@ -52,11 +67,44 @@ class Image565
 {
 public:
 
-    Image565(int16_t width, int16_t height);
+    // Pixel storage always starts on a cache line. With ALIGNED, every row
+    // does too, as the stride is padded to a multiple of sc_rowAlignment
+    // bytes. PACKED rows follow each other with no gap, so the whole
+    // image is one contiguous block.
+
+    enum class Layout { PACKED, ALIGNED };
+
+    static constexpr size_t sc_rowAlignment{64};
+
+    Image565(int16_t width, int16_t height, Layout layout = Layout::PACKED);
+
+    Image565(const Image565& image) = default;
+    Image565& operator=(const Image565& image) = default;
+
+    // A moved from image is left empty (0 x 0).
+
+    Image565(Image565&& image) noexcept;
+    Image565& operator=(Image565&& image) noexcept;
 
     int16_t getWidth() const { return m_width; }
     int16_t getHeight() const { return m_height; }
 
+    // The distance in pixels from the start of one row to the next.
+
+    int32_t getStride() const { return m_stride; }
+    static int32_t stride(int16_t width, Layout layout);
+    bool isPacked() const { return m_stride == m_width; }
+
+    // Change the size and layout of the image. The buffer is only
+    // reallocated if it has fewer than stride x height pixels of capacity.
+    // The pixels are left as they were in the buffer, so should be
+    // redrawn.
+
+    void reshape(int16_t width, int16_t height, Layout layout);
+
+    size_t getCapacity() const { return m_buffer.capacity(); }
+    void reserve(size_t pixels) { m_buffer.reserve(pixels); }
+
     void clear(const RGB565& rgb) { clear(rgb.get565()); }
     void clear(uint16_t rgb);
 
@@ -73,8 +121,34 @@ public:
     std::pair<bool, RGB565> getPixelRGB(const Image565Point& p) const;
     std::pair<bool, uint16_t> getPixel(const Image565Point& p) const;
 
+    uint16_t* getRow(int16_t y);
     const uint16_t* getRow(int16_t y) const;
 
+    // Pixels x0 to x1 (inclusive, in either order) of row y, clipped to
+    // the image. The length is zero if none of them are in the image.
+
+    Image565Span rowSpan(int16_t y, int16_t x0, int16_t x1);
+
+    // Move the pixels in the rectangle (or the whole image) by dx, dy.
+    // Pixels moved out of the rectangle are lost and the area uncovered
+    // is filled with rgb.
+
+    void
+    scroll(
+        const Image565Rectangle& rectangle,
+        int16_t dx,
+        int16_t dy,
+        uint16_t rgb);
+
+    void
+    scroll(
+        int16_t dx,
+        int16_t dy,
+        uint16_t rgb)
+    {
+        scroll(Image565Rectangle(0, 0, m_width, m_height), dx, dy, rgb);
+    }
+
 private:
 
     bool
@@ -86,9 +160,54 @@ private:
                 (p.y() < m_height));
     }
 
+    using Buffer =
+        std::vector<uint16_t, AlignedAllocator<uint16_t, sc_rowAlignment>>;
+
     int16_t m_width;
     int16_t m_height;
-    std::vector<uint16_t> m_buffer;
+    int32_t m_stride;
+    Buffer m_buffer;
+};
+
+//-------------------------------------------------------------------------
+
+// Moves around an image writing pixels without any bounds checks, for
+// code that has already clipped what it draws to the image.
+
+class Image565Cursor
+{
+public:
+
+    Image565Cursor(
+        Image565& image,
+        const Image565Point& p)
+    :
+        m_pixel{image.getRow(p.y()) + p.x()},
+        m_stride{image.getStride()}
+    {
+    }
+
+    Image565Cursor(
+        uint16_t* pixel,
+        int32_t stride)
+    :
+        m_pixel{pixel},
+        m_stride{stride}
+    {
+    }
+
+    void set(uint16_t rgb) { *m_pixel = rgb; }
+    uint16_t get() const { return *m_pixel; }
+
+    void left() { --m_pixel; }
+    void right() { ++m_pixel; }
+    void up() { m_pixel -= m_stride; }
+    void down() { m_pixel += m_stride; }
+
+private:
+
+    uint16_t* m_pixel;
+    int32_t m_stride;
 };
 
 //-------------------------------------------------------------------------
@@ -0,0 +1,177 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#include <algorithm>
+
+#include "blend565.h"
+#include "image565Alpha.h"
+#include "image565View.h"
+
+//-------------------------------------------------------------------------
+
+raspifb16::Image565Alpha:: Image565Alpha(
+    int16_t width,
+    int16_t height)
+:
+    m_image(width, height),
+    m_alpha(width * height, 0)
+{
+}
+
+//-------------------------------------------------------------------------
+
+raspifb16::Image565Alpha:: Image565Alpha(
+    const Image565& image,
+    uint8_t alpha)
+:
+    m_image(image),
+    m_alpha(image.getWidth() * image.getHeight(), alpha)
+{
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::Image565Alpha:: clear(
+    const RGB565& rgb,
+    uint8_t alpha)
+{
+    m_image.clear(rgb);
+    clearAlpha(alpha);
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::Image565Alpha:: clearAlpha(
+    uint8_t alpha)
+{
+    std::fill(m_alpha.begin(), m_alpha.end(), alpha);
+}
+
+//-------------------------------------------------------------------------
+
+bool
+raspifb16::Image565Alpha:: setPixel(
+    const Image565Point& p,
+    uint16_t rgb,
+    uint8_t alpha)
+{
+    bool isValid{m_image.setPixel(p, rgb)};
+
+    if (isValid)
+    {
+        m_alpha[p.x() + (p.y() * getWidth())] = alpha;
+    }
+
+    return isValid;
+}
+
+//-------------------------------------------------------------------------
+
+bool
+raspifb16::Image565Alpha:: setAlpha(
+    const Image565Point& p,
+    uint8_t alpha)
+{
+    bool isValid{validPixel(p)};
+
+    if (isValid)
+    {
+        m_alpha[p.x() + (p.y() * getWidth())] = alpha;
+    }
+
+    return isValid;
+}
+
+//-------------------------------------------------------------------------
+
+std::pair<bool, uint8_t>
+raspifb16::Image565Alpha:: getAlpha(
+    const Image565Point& p) const
+{
+    bool isValid{validPixel(p)};
+    uint8_t alpha{0};
+
+    if (isValid)
+    {
+        alpha = m_alpha[p.x() + (p.y() * getWidth())];
+    }
+
+    return std::make_pair(isValid, alpha);
+}
+
+//-------------------------------------------------------------------------
+
+const uint8_t*
+raspifb16::Image565Alpha:: getAlphaRow(
+    int16_t y) const
+{
+    if (validPixel(Image565Point{0, y}))
+    {
+        return m_alpha.data() + (y * getWidth());
+    }
+    else
+    {
+        return nullptr;
+    }
+}
+
+//-------------------------------------------------------------------------
+
+bool
+raspifb16::blendImage(
+    Image565View image,
+    const Image565Point& p,
+    const Image565Alpha& overlay)
+{
+    int32_t x0 = std::max<int32_t>(p.x(), 0);
+    int32_t x1 = std::min<int32_t>(p.x() + overlay.getWidth(),
+                                   image.getWidth());
+    int32_t y0 = std::max<int32_t>(p.y(), 0);
+    int32_t y1 = std::min<int32_t>(p.y() + overlay.getHeight(),
+                                   image.getHeight());
+
+    if ((x0 >= x1) || (y0 >= y1))
+    {
+        return false;
+    }
+
+    for (int32_t j = y0 ; j < y1 ; ++j)
+    {
+        int16_t sy = j - p.y();
+        int32_t sx = x0 - p.x();
+
+        blendRow(image.getRow(j) + x0,
+                 overlay.getRow(sy) + sx,
+                 overlay.getAlphaRow(sy) + sx,
+                 x1 - x0);
+    }
+
+    return true;
+}
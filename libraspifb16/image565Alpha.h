@@ -0,0 +1,115 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef IMAGE565_ALPHA_H
+#define IMAGE565_ALPHA_H
+
+//-------------------------------------------------------------------------
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "image565.h"
+#include "image565View.h"
+#include "point.h"
+#include "rgb565.h"
+
+//-------------------------------------------------------------------------
+
+namespace raspifb16
+{
+
+//-------------------------------------------------------------------------
+
+// An RGB565 image with an 8 bit alpha plane (0 is fully transparent, 255
+// is fully opaque). The colour plane is an ordinary Image565, so the
+// graphics and font functions can be used to draw into it.
+
+class Image565Alpha
+{
+public:
+
+    Image565Alpha(int16_t width, int16_t height);
+    explicit Image565Alpha(const Image565& image, uint8_t alpha = 0xFF);
+
+    int16_t getWidth() const { return m_image.getWidth(); }
+    int16_t getHeight() const { return m_image.getHeight(); }
+
+    Image565& getImage() { return m_image; }
+    const Image565& getImage() const { return m_image; }
+
+    void clear(const RGB565& rgb, uint8_t alpha);
+    void clearAlpha(uint8_t alpha);
+
+    bool setPixel(const Image565Point& p, uint16_t rgb, uint8_t alpha);
+    bool setAlpha(const Image565Point& p, uint8_t alpha);
+
+    std::pair<bool, uint16_t>
+    getPixel(const Image565Point& p) const
+    {
+        return m_image.getPixel(p);
+    }
+
+    std::pair<bool, uint8_t> getAlpha(const Image565Point& p) const;
+
+    const uint16_t* getRow(int16_t y) const { return m_image.getRow(y); }
+    const uint8_t* getAlphaRow(int16_t y) const;
+
+private:
+
+    bool
+    validPixel(const Image565Point& p) const
+    {
+        return ((p.x() >= 0) &&
+                (p.y() >= 0) &&
+                (p.x() < getWidth()) &&
+                (p.y() < getHeight()));
+    }
+
+    Image565 m_image;
+    std::vector<uint8_t> m_alpha;
+};
+
+//-------------------------------------------------------------------------
+
+// Blend overlay onto image with its top left corner at p.
+
+bool
+blendImage(
+    Image565View image,
+    const Image565Point& p,
+    const Image565Alpha& overlay);
+
+//-------------------------------------------------------------------------
+
+} // namespace raspifb16
+
+//-------------------------------------------------------------------------
+
+#endif
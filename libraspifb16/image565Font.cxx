@@ -27,6 +27,7 @@
 
 #include "image565.h"
 #include "image565Font.h"
+#include "image565View.h"
 #include "point.h"
 #include "rgb565.h"
 
@@ -4660,7 +4661,7 @@ raspifb16::drawChar(
     const Image565Point& p,
     uint8_t c,
     const RGB565& rgb,
-    Image565& image)
+    Image565View image)
 {
     return drawChar(p, c, rgb.get565(), image);
 }
@@ -4672,22 +4673,31 @@ raspifb16::drawChar(
     const Image565Point& p,
     uint8_t c,
     uint16_t rgb,
-    Image565& image)
+    Image565View image)
 {
     for (int16_t j = 0 ; j < sc_fontHeight ; ++j)
     {
         uint8_t byte = font[c][j];
 
-        if (byte != 0)
+        auto span = image.rowSpan(p.y() + j,
+                                  p.x(),
+                                  p.x() + sc_fontWidth - 1);
+
+        if ((byte != 0) && (span.m_length > 0))
         {
-            for (int16_t i = 0 ; i < sc_fontWidth ; ++i)
+            // Shift the glyph row so the first pixel in the span is the
+            // top bit.
+
+            byte <<= (span.m_x - p.x());
+
+            for (int16_t i = 0 ; i < span.m_length ; ++i)
             {
-                if ((byte >> (sc_fontWidth - i - 1)) & 1 )
+                if (byte & 0x80)
                 {
-                    image.setPixel(
-                        Image565Point(p.x() + i, p.y() + j),
-                        rgb);
+                    span.m_pixels[i] = rgb;
                 }
+
+                byte <<= 1;
             }
         }
     }
@@ -4702,7 +4712,7 @@ raspifb16::drawString(
     const Image565Point& p,
     const char* string,
     const RGB565& rgb,
-    Image565& image)
+    Image565View image)
 {
     FontPoint position{p};
 
@@ -4740,7 +4750,7 @@ raspifb16::drawString(
     const Image565Point& p,
     const std::string& string,
     const RGB565& rgb,
-    Image565& image)
+    Image565View image)
 {
     return drawString(p, string.c_str(), rgb, image);
 }
@@ -33,7 +33,7 @@
 #include <cstdint>
 #include <string>
 
-#include "image565.h"
+#include "image565View.h"
 #include "point.h"
 
 //-------------------------------------------------------------------------
@@ -61,28 +61,28 @@ drawChar(
     const Image565Point& p,
     uint8_t c,
     const RGB565& rgb,
-    Image565& image);
+    Image565View image);
 
 FontPoint
 drawChar(
     const Image565Point& p,
     uint8_t c,
     uint16_t rgb,
-    Image565& image);
+    Image565View image);
 
 FontPoint
 drawString(
     const Image565Point& p,
     const char* string,
     const RGB565& rgb,
-    Image565& image);
+    Image565View image);
 
 FontPoint
 drawString(
     const Image565Point& p,
     const std::string& string,
     const RGB565& rgb,
-    Image565& image);
+    Image565View image);
 
 //-------------------------------------------------------------------------
 
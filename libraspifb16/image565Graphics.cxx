@@ -25,11 +25,13 @@
 //
 //-------------------------------------------------------------------------
 
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
 
 #include "image565.h"
 #include "image565Graphics.h"
+#include "image565View.h"
 #include "point.h"
 
 //-------------------------------------------------------------------------
@@ -37,7 +39,7 @@
 void
 raspifb16::
 box(
-    Image565& image,
+    Image565View image,
     const Image565Point& p1,
     const Image565Point& p2,
     uint16_t rgb)
@@ -53,20 +55,19 @@ box(
 void
 raspifb16::
 boxFilled(
-    Image565& image,
+    Image565View image,
     const Image565Point& p1,
     const Image565Point& p2,
     uint16_t rgb)
 {
-    int16_t sign_y = (p1.y() <= p2.y()) ? 1 : -1;
-    int16_t y = p1.y();
+    int16_t y1 = std::max<int16_t>(std::min(p1.y(), p2.y()), 0);
+    int16_t y2 = std::min<int16_t>(std::max(p1.y(), p2.y()),
+                                   image.getHeight() - 1);
 
-    horizontalLine(image, p1.x(), p2.x(), y, rgb);
-
-    while (y != p2.y())
+    for (int16_t y = y1 ; y <= y2 ; ++y)
     {
-        y += sign_y;
-        horizontalLine(image, p1.x(), p2.x(), y, rgb);
+        auto span = image.rowSpan(y, p1.x(), p2.x());
+        std::fill_n(span.m_pixels, span.m_length, rgb);
     }
 }
 
@@ -75,7 +76,7 @@ boxFilled(
 void
 raspifb16::
 line(
-    Image565& image,
+    Image565View image,
     const Image565Point& p1,
     const Image565Point& p2,
     uint16_t rgb)
@@ -155,22 +156,14 @@ line(
 void
 raspifb16::
 horizontalLine(
-    Image565& image,
+    Image565View image,
     int16_t x1,
     int16_t x2,
     int16_t y,
     uint16_t rgb)
 {
-    int16_t sign_x = (x1 <= x2) ? 1 : -1;
-    int16_t x = x1;
-
-    image.setPixel(Image565Point(x, y), rgb);
-
-    while (x != x2)
-    {
-        x += sign_x;
-        image.setPixel(Image565Point(x, y), rgb);
-    }
+    auto span = image.rowSpan(y, x1, x2);
+    std::fill_n(span.m_pixels, span.m_length, rgb);
 }
 
 //-------------------------------------------------------------------------
@@ -178,21 +171,34 @@ horizontalLine(
 void
 raspifb16::
 verticalLine(
-    Image565& image,
+    Image565View image,
     int16_t x,
     int16_t y1,
     int16_t y2,
     uint16_t rgb)
 {
-    int16_t sign_y = (y1 <= y2) ? 1 : -1;
-    int16_t y = y1;
+    if ((x < 0) || (x >= image.getWidth()))
+    {
+        return;
+    }
+
+    int16_t top = std::max<int16_t>(std::min(y1, y2), 0);
+    int16_t bottom = std::min<int16_t>(std::max(y1, y2),
+                                       image.getHeight() - 1);
+
+    if (top > bottom)
+    {
+        return;
+    }
 
-    image.setPixel(Image565Point(x, y), rgb);
+    Image565Cursor cursor{image.getRow(top) + x, image.getStride()};
 
-    while (y != y2)
+    for (int16_t y = top ; y < bottom ; ++y)
     {
-        y += sign_y;
-        image.setPixel(Image565Point(x, y), rgb);
+        cursor.set(rgb);
+        cursor.down();
     }
+
+    cursor.set(rgb);
 }
 
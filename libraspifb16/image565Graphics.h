@@ -32,7 +32,7 @@
 
 #include <cstdint>
 
-#include "image565.h"
+#include "image565View.h"
 #include "point.h"
 #include "rgb565.h"
 
@@ -45,14 +45,14 @@ namespace raspifb16
 
 void
 box(
-    Image565& image,
+    Image565View image,
     const Image565Point& p1,
     const Image565Point& p2,
     uint16_t rgb);
 
 inline void
 box(
-    Image565& image,
+    Image565View image,
     const Image565Point& p1,
     const Image565Point& p2,
     const RGB565& rgb)
@@ -64,14 +64,14 @@ box(
 
 void
 boxFilled(
-    Image565& image,
+    Image565View image,
     const Image565Point& p1,
     const Image565Point& p2,
     uint16_t rgb);
 
 inline void
 boxFilled(
-    Image565& image,
+    Image565View image,
     const Image565Point& p1,
     const Image565Point& p2,
     const RGB565& rgb)
@@ -83,14 +83,14 @@ boxFilled(
 
 void
 line(
-    Image565& image,
+    Image565View image,
     const Image565Point& p1,
     const Image565Point& p2,
     uint16_t rgb);
 
 inline void
 line(
-    Image565& image,
+    Image565View image,
     const Image565Point& p1,
     const Image565Point& p2,
     const RGB565& rgb)
@@ -102,7 +102,7 @@ line(
 
 void
 horizontalLine(
-    Image565& image,
+    Image565View image,
     int16_t x1,
     int16_t x2,
     int16_t y,
@@ -110,7 +110,7 @@ horizontalLine(
 
 inline void
 horizontalLine(
-    Image565& image,
+    Image565View image,
     int16_t x1,
     int16_t x2,
     int16_t y,
@@ -123,7 +123,7 @@ horizontalLine(
 
 void
 verticalLine(
-    Image565& image,
+    Image565View image,
     int16_t x,
     int16_t y1,
     int16_t y2,
@@ -131,7 +131,7 @@ verticalLine(
 
 inline void
 verticalLine(
-    Image565& image,
+    Image565View image,
     int16_t x,
     int16_t y1,
     int16_t y2,
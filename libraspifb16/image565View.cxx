@@ -0,0 +1,180 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#include <algorithm>
+
+#include "image565View.h"
+
+//-------------------------------------------------------------------------
+
+raspifb16::Image565View:: Image565View()
+:
+    m_pixels{nullptr},
+    m_width{0},
+    m_height{0},
+    m_stride{0}
+{
+}
+
+//-------------------------------------------------------------------------
+
+raspifb16::Image565View:: Image565View(
+    uint16_t* pixels,
+    int16_t width,
+    int16_t height,
+    int32_t stride)
+:
+    m_pixels{pixels},
+    m_width{width},
+    m_height{height},
+    m_stride{stride}
+{
+}
+
+//-------------------------------------------------------------------------
+
+raspifb16::Image565View:: Image565View(
+    Image565& image)
+:
+    m_pixels{image.getRow(0)},
+    m_width{image.getWidth()},
+    m_height{image.getHeight()},
+    m_stride{image.getStride()}
+{
+    if (m_pixels == nullptr)
+    {
+        m_width = 0;
+        m_height = 0;
+    }
+}
+
+//-------------------------------------------------------------------------
+
+raspifb16::Image565View:: Image565View(
+    Image565& image,
+    const Image565Rectangle& rectangle)
+:
+    Image565View(Image565View(image), rectangle)
+{
+}
+
+//-------------------------------------------------------------------------
+
+raspifb16::Image565View:: Image565View(
+    const Image565View& view,
+    const Image565Rectangle& rectangle)
+:
+    Image565View()
+{
+    auto area = rectangle.intersection(
+        Image565Rectangle(0, 0, view.getWidth(), view.getHeight()));
+
+    if (!area.empty())
+    {
+        m_pixels = view.getRow(area.y()) + area.x();
+        m_width = area.width();
+        m_height = area.height();
+        m_stride = view.getStride();
+    }
+}
+
+//-------------------------------------------------------------------------
+
+bool
+raspifb16::Image565View:: setPixel(
+    const Image565Point& p,
+    uint16_t rgb) const
+{
+    bool isValid{validPixel(p)};
+
+    if (isValid)
+    {
+        m_pixels[p.x() + (p.y() * m_stride)] = rgb;
+    }
+
+    return isValid;
+}
+
+//-------------------------------------------------------------------------
+
+std::pair<bool, uint16_t>
+raspifb16::Image565View:: getPixel(
+    const Image565Point& p) const
+{
+    bool isValid{validPixel(p)};
+    uint16_t rgb{0};
+
+    if (isValid)
+    {
+        rgb = m_pixels[p.x() + (p.y() * m_stride)];
+    }
+
+    return std::make_pair(isValid, rgb);
+}
+
+//-------------------------------------------------------------------------
+
+uint16_t*
+raspifb16::Image565View:: getRow(
+    int16_t y) const
+{
+    if (validPixel(Image565Point{0, y}))
+    {
+        return m_pixels + (y * m_stride);
+    }
+    else
+    {
+        return nullptr;
+    }
+}
+
+//-------------------------------------------------------------------------
+
+raspifb16::Image565Span
+raspifb16::Image565View:: rowSpan(
+    int16_t y,
+    int16_t x0,
+    int16_t x1) const
+{
+    if (x0 > x1)
+    {
+        std::swap(x0, x1);
+    }
+
+    x0 = std::max<int16_t>(x0, 0);
+    x1 = std::min<int16_t>(x1, m_width - 1);
+
+    if ((y < 0) || (y >= m_height) || (x0 > x1))
+    {
+        return Image565Span{nullptr, 0, 0};
+    }
+
+    return Image565Span{m_pixels + (y * m_stride) + x0,
+                        x0,
+                        static_cast<int16_t>(x1 - x0 + 1)};
+}
@@ -0,0 +1,115 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef IMAGE565_VIEW_H
+#define IMAGE565_VIEW_H
+
+//-------------------------------------------------------------------------
+
+#include <cstdint>
+#include <utility>
+
+#include "image565.h"
+#include "point.h"
+#include "rectangle.h"
+
+//-------------------------------------------------------------------------
+
+namespace raspifb16
+{
+
+//-------------------------------------------------------------------------
+
+// A width x height window onto RGB565 pixels that someone else owns,
+// stride pixels apart from one row to the next. Views are small and are
+// passed by value. Drawing through one only touches the pixels inside
+// it, so a view of part of an image (or of the framebuffer) can be drawn
+// into without a separate image and a copy.
+//
+// An Image565 converts to a view of the whole image, so any function
+// that takes a view can also be given an image.
+
+class Image565View
+{
+public:
+
+    Image565View();
+
+    Image565View(
+        uint16_t* pixels,
+        int16_t width,
+        int16_t height,
+        int32_t stride);
+
+    Image565View(Image565& image);
+
+    // The part of the image (or view) inside the rectangle.
+
+    Image565View(Image565& image, const Image565Rectangle& rectangle);
+    Image565View(const Image565View& view, const Image565Rectangle& rectangle);
+
+    int16_t getWidth() const { return m_width; }
+    int16_t getHeight() const { return m_height; }
+    int32_t getStride() const { return m_stride; }
+
+    bool empty() const { return (m_width <= 0) || (m_height <= 0); }
+
+    bool setPixel(const Image565Point& p, uint16_t rgb) const;
+    std::pair<bool, uint16_t> getPixel(const Image565Point& p) const;
+
+    uint16_t* getRow(int16_t y) const;
+
+    // Pixels x0 to x1 (inclusive, in either order) of row y, clipped to
+    // the view. The length is zero if none of them are in the view.
+
+    Image565Span rowSpan(int16_t y, int16_t x0, int16_t x1) const;
+
+private:
+
+    bool
+    validPixel(const Image565Point& p) const
+    {
+        return ((p.x() >= 0) &&
+                (p.y() >= 0) &&
+                (p.x() < m_width) &&
+                (p.y() < m_height));
+    }
+
+    uint16_t* m_pixels;
+    int16_t m_width;
+    int16_t m_height;
+    int32_t m_stride;
+};
+
+//-------------------------------------------------------------------------
+
+} // namespace raspifb16
+
+//-------------------------------------------------------------------------
+
+#endif
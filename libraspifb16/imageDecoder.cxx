@@ -0,0 +1,1223 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+#ifdef RASPIFB16_ZLIB
+#include <zlib.h>
+#endif
+
+#include "imageDecoder.h"
+
+//-------------------------------------------------------------------------
+
+namespace
+{
+
+//-------------------------------------------------------------------------
+
+using namespace raspifb16;
+
+//-------------------------------------------------------------------------
+
+// Reads the input a block at a time, so the decoders can look at several
+// bytes at once without a call to the stream for each one.
+
+class InputBuffer
+{
+public:
+
+    explicit InputBuffer(std::istream& input);
+
+    // Try to have at least count bytes available. Returns how many there
+    // are, which is fewer than count only at the end of the input.
+
+    size_t
+    fill(size_t count)
+    {
+        return (available() >= count) ? available() : refill(count);
+    }
+
+    const uint8_t* data() const { return m_buffer.data() + m_position; }
+    size_t available() const { return m_end - m_position; }
+    void consume(size_t count) { m_position += count; }
+
+    uint8_t get();
+    void read(uint8_t* data, size_t count);
+
+    void
+    skip(size_t count)
+    {
+        while (count > 0)
+        {
+            auto length = std::min(count, fill(count));
+
+            if (length == 0)
+            {
+                throw std::runtime_error{"unexpected end of image data"};
+            }
+
+            consume(length);
+            count -= length;
+        }
+    }
+
+private:
+
+    static constexpr size_t sc_size{65536};
+
+    size_t refill(size_t count);
+
+    std::istream& m_input;
+    std::vector<uint8_t> m_buffer;
+    size_t m_position;
+    size_t m_end;
+};
+
+//-------------------------------------------------------------------------
+
+constexpr size_t InputBuffer::sc_size;
+
+//-------------------------------------------------------------------------
+
+InputBuffer:: InputBuffer(
+    std::istream& input)
+:
+    m_input(input),
+    m_buffer(sc_size),
+    m_position{0},
+    m_end{0}
+{
+}
+
+//-------------------------------------------------------------------------
+
+size_t
+InputBuffer:: refill(
+    size_t count)
+{
+    count = std::min(count, sc_size);
+
+    if (m_position > 0)
+    {
+        std::memmove(m_buffer.data(), data(), available());
+        m_end -= m_position;
+        m_position = 0;
+    }
+
+    while ((m_end < count) && m_input)
+    {
+        m_input.read(reinterpret_cast<char*>(m_buffer.data() + m_end),
+                     sc_size - m_end);
+        m_end += m_input.gcount();
+    }
+
+    return available();
+}
+
+//-------------------------------------------------------------------------
+
+uint8_t
+InputBuffer:: get()
+{
+    if (fill(1) == 0)
+    {
+        throw std::runtime_error{"unexpected end of image data"};
+    }
+
+    return m_buffer[m_position++];
+}
+
+//-------------------------------------------------------------------------
+
+void
+InputBuffer:: read(
+    uint8_t* data,
+    size_t count)
+{
+    while (count > 0)
+    {
+        auto length = std::min(count, fill(count));
+
+        if (length == 0)
+        {
+            throw std::runtime_error{"unexpected end of image data"};
+        }
+
+        std::memcpy(data, this->data(), length);
+        consume(length);
+        data += length;
+        count -= length;
+    }
+}
+
+//-------------------------------------------------------------------------
+
+uint32_t
+bigEndian32(
+    const uint8_t* data)
+{
+    return (uint32_t(data[0]) << 24) |
+           (uint32_t(data[1]) << 16) |
+           (uint32_t(data[2]) << 8) |
+           uint32_t(data[3]);
+}
+
+//-------------------------------------------------------------------------
+
+Image565
+createImage(
+    uint32_t width,
+    uint32_t height,
+    const char* format)
+{
+    if ((width == 0) || (height == 0) || (width > 32767) || (height > 32767))
+    {
+        throw std::runtime_error{std::string{"unsupported "} +
+                                 format +
+                                 " image size " +
+                                 std::to_string(width) +
+                                 "x" +
+                                 std::to_string(height)};
+    }
+
+    return Image565(width, height);
+}
+
+//-------------------------------------------------------------------------
+// PPM
+
+void
+skipPpmSpace(
+    InputBuffer& input)
+{
+    while (input.fill(1) > 0)
+    {
+        auto c = *input.data();
+
+        if (c == '#')
+        {
+            while (input.get() != '\n')
+            {
+            }
+        }
+        else if (std::isspace(c))
+        {
+            input.consume(1);
+        }
+        else
+        {
+            break;
+        }
+    }
+}
+
+//-------------------------------------------------------------------------
+
+uint32_t
+readPpmNumber(
+    InputBuffer& input)
+{
+    skipPpmSpace(input);
+
+    uint32_t value{0};
+    int digits{0};
+
+    while ((input.fill(1) > 0) && std::isdigit(*input.data()))
+    {
+        value = (value * 10) + (input.get() - '0');
+
+        if (++digits > 9)
+        {
+            throw std::runtime_error{"bad PPM header"};
+        }
+    }
+
+    if (digits == 0)
+    {
+        throw std::runtime_error{"bad PPM header"};
+    }
+
+    return value;
+}
+
+//-------------------------------------------------------------------------
+
+Image565
+decodePpm(
+    InputBuffer& input,
+    Dither dither)
+{
+    uint8_t magic[2];
+    input.read(magic, sizeof(magic));
+
+    if ((magic[0] != 'P') || ((magic[1] != '5') && (magic[1] != '6')))
+    {
+        throw std::runtime_error{"not a binary PPM or PGM image"};
+    }
+
+    const int channels = (magic[1] == '6') ? 3 : 1;
+    const auto width = readPpmNumber(input);
+    const auto height = readPpmNumber(input);
+    const auto maxval = readPpmNumber(input);
+
+    if ((maxval == 0) || (maxval > 65535) || (std::isspace(input.get()) == 0))
+    {
+        throw std::runtime_error{"bad PPM header"};
+    }
+
+    auto image = createImage(width, height, "PPM");
+    const size_t sampleBytes = (maxval > 255) ? 2 : 1;
+    const size_t samples = size_t(width) * channels;
+
+    std::vector<uint8_t> raw(samples * sampleBytes);
+    std::vector<uint8_t> rgb(size_t(width) * 3);
+    const bool direct = (channels == 3) && (maxval == 255);
+
+    for (uint32_t y = 0 ; y < height ; ++y)
+    {
+        input.read(raw.data(), raw.size());
+
+        if (!direct)
+        {
+            for (size_t i = 0 ; i < samples ; ++i)
+            {
+                uint32_t value = raw[i * sampleBytes];
+
+                if (sampleBytes == 2)
+                {
+                    value = (value << 8) | raw[(i * 2) + 1];
+                }
+
+                value = std::min(value, maxval);
+                value = ((value * 255) + (maxval / 2)) / maxval;
+
+                if (channels == 3)
+                {
+                    rgb[i] = value;
+                }
+                else
+                {
+                    std::fill_n(rgb.begin() + (i * 3), 3, value);
+                }
+            }
+        }
+
+        convertRow888((direct) ? raw.data() : rgb.data(),
+                      image.getRow(y),
+                      width,
+                      y,
+                      dither);
+    }
+
+    return image;
+}
+
+//-------------------------------------------------------------------------
+// QOI
+
+struct QoiPixel
+{
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+    uint8_t a;
+};
+
+//-------------------------------------------------------------------------
+
+inline int
+qoiHash(
+    const QoiPixel& p)
+{
+    return ((p.r * 3) + (p.g * 5) + (p.b * 7) + (p.a * 11)) & 63;
+}
+
+//-------------------------------------------------------------------------
+
+struct QoiState
+{
+    std::array<QoiPixel, 64> m_index;
+    QoiPixel m_pixel;
+    uint32_t m_run;
+};
+
+//-------------------------------------------------------------------------
+
+// Decode one row of width pixels, calling put(x, pixel) for each and
+// fill(x, length, pixel) for a run.
+
+template<typename Put, typename Fill>
+void
+decodeQoiRow(
+    InputBuffer& input,
+    QoiState& state,
+    uint32_t width,
+    Put put,
+    Fill fill)
+{
+    auto p = state.m_pixel;
+    auto& index = state.m_index;
+
+    // A run can carry on from the row before.
+
+    uint32_t x = std::min(state.m_run, width);
+    fill(0, x, p);
+    state.m_run -= x;
+
+    // The longest chunk is five bytes, and a QOI stream always ends with
+    // eight bytes of padding, so chunks can be decoded without checking
+    // the input until fewer than five bytes are left in the buffer.
+
+    while (x < width)
+    {
+        if (input.fill(5) < 5)
+        {
+            throw std::runtime_error{"truncated QOI image"};
+        }
+
+        const auto start = input.data();
+        const auto last = start + input.available() - 4;
+        auto in = start;
+
+        while ((x < width) && (in < last))
+        {
+            const uint8_t b1 = *(in++);
+
+            if (b1 >= 0xC0)
+            {
+                if (b1 == 0xFE)
+                {
+                    p.r = in[0];
+                    p.g = in[1];
+                    p.b = in[2];
+                    in += 3;
+                }
+                else if (b1 == 0xFF)
+                {
+                    p.r = in[0];
+                    p.g = in[1];
+                    p.b = in[2];
+                    p.a = in[3];
+                    in += 4;
+                }
+                else
+                {
+                    const uint32_t run = (b1 & 63) + 1;
+                    const auto length = std::min(run, width - x);
+
+                    fill(x, length, p);
+                    x += length;
+                    state.m_run = run - length;
+                    continue;
+                }
+            }
+            else if (b1 < 0x40)
+            {
+                p = index[b1];
+            }
+            else if (b1 < 0x80)
+            {
+                p.r += ((b1 >> 4) & 3) - 2;
+                p.g += ((b1 >> 2) & 3) - 2;
+                p.b += (b1 & 3) - 2;
+            }
+            else
+            {
+                const int dg = (b1 & 63) - 32;
+                const uint8_t b2 = *(in++);
+
+                p.r += dg - 8 + (b2 >> 4);
+                p.g += dg;
+                p.b += dg - 8 + (b2 & 15);
+            }
+
+            index[qoiHash(p)] = p;
+            put(x++, p);
+        }
+
+        input.consume(in - start);
+    }
+
+    state.m_pixel = p;
+}
+
+//-------------------------------------------------------------------------
+
+inline uint16_t
+qoi565(
+    const QoiPixel& p)
+{
+    return ((p.r & 0xF8) << 8) | ((p.g & 0xFC) << 3) | (p.b >> 3);
+}
+
+//-------------------------------------------------------------------------
+
+Image565
+decodeQoi(
+    InputBuffer& input,
+    Dither dither)
+{
+    uint8_t header[14];
+    input.read(header, sizeof(header));
+
+    if (std::memcmp(header, "qoif", 4) != 0)
+    {
+        throw std::runtime_error{"not a QOI image"};
+    }
+
+    const auto width = bigEndian32(header + 4);
+    const auto height = bigEndian32(header + 8);
+    auto image = createImage(width, height, "QOI");
+
+    QoiState state{{}, {0, 0, 0, 255}, 0};
+
+    if (dither == Dither::NONE)
+    {
+        // Without dithering each pixel only depends on its own colour, so
+        // it can be written straight to the image.
+
+        for (uint32_t y = 0 ; y < height ; ++y)
+        {
+            auto row = image.getRow(y);
+
+            decodeQoiRow(input,
+                         state,
+                         width,
+                         [row](uint32_t x, const QoiPixel& p)
+                         {
+                             row[x] = qoi565(p);
+                         },
+                         [row](uint32_t x, uint32_t length, const QoiPixel& p)
+                         {
+                             std::fill_n(row + x, length, qoi565(p));
+                         });
+        }
+
+        return image;
+    }
+
+    std::vector<uint8_t> rgb(size_t(width) * 3);
+    auto out = rgb.data();
+
+    for (uint32_t y = 0 ; y < height ; ++y)
+    {
+        decodeQoiRow(input,
+                     state,
+                     width,
+                     [out](uint32_t x, const QoiPixel& p)
+                     {
+                         out[x * 3] = p.r;
+                         out[(x * 3) + 1] = p.g;
+                         out[(x * 3) + 2] = p.b;
+                     },
+                     [out](uint32_t x, uint32_t length, const QoiPixel& p)
+                     {
+                         for (auto i = x * 3 ; i < (x + length) * 3 ; i += 3)
+                         {
+                             out[i] = p.r;
+                             out[i + 1] = p.g;
+                             out[i + 2] = p.b;
+                         }
+                     });
+
+        convertRow888(out, image.getRow(y), width, y, dither);
+    }
+
+    return image;
+}
+
+//-------------------------------------------------------------------------
+// PNG
+
+#ifdef RASPIFB16_ZLIB
+
+class PngDecoder
+{
+public:
+
+    PngDecoder(InputBuffer& input, Dither dither);
+    ~PngDecoder();
+
+    PngDecoder(const PngDecoder&) = delete;
+    PngDecoder& operator=(const PngDecoder&) = delete;
+
+    Image565 decode();
+
+private:
+
+    void readHeader(const uint8_t* data);
+    void readPalette(const uint8_t* data, uint32_t length);
+    void inflateData(uint32_t length);
+    void unfilterRow();
+    void convertRow();
+
+    InputBuffer& m_input;
+    Dither m_dither;
+    z_stream m_zstream;
+    bool m_zstreamEnd;
+
+    uint32_t m_width;
+    uint32_t m_height;
+    int m_bitDepth;
+    int m_colourType;
+    size_t m_pixelBytes;
+    size_t m_rowBytes;
+
+    std::vector<uint8_t> m_palette;
+    std::vector<uint8_t> m_row;
+    std::vector<uint8_t> m_previous;
+    std::vector<uint8_t> m_rgb;
+    size_t m_filled;
+    uint32_t m_y;
+    Image565 m_image;
+};
+
+//-------------------------------------------------------------------------
+
+PngDecoder:: PngDecoder(
+    InputBuffer& input,
+    Dither dither)
+:
+    m_input(input),
+    m_dither{dither},
+    m_zstream{},
+    m_zstreamEnd{false},
+    m_width{0},
+    m_height{0},
+    m_bitDepth{0},
+    m_colourType{0},
+    m_pixelBytes{0},
+    m_rowBytes{0},
+    m_palette(),
+    m_row(),
+    m_previous(),
+    m_rgb(),
+    m_filled{0},
+    m_y{0},
+    m_image(0, 0)
+{
+    if (inflateInit(&m_zstream) != Z_OK)
+    {
+        throw std::runtime_error{"cannot initialise zlib"};
+    }
+}
+
+//-------------------------------------------------------------------------
+
+PngDecoder:: ~PngDecoder()
+{
+    inflateEnd(&m_zstream);
+}
+
+//-------------------------------------------------------------------------
+
+Image565
+PngDecoder:: decode()
+{
+    static constexpr uint8_t signature[8]{137, 80, 78, 71, 13, 10, 26, 10};
+
+    uint8_t header[8];
+    m_input.read(header, sizeof(header));
+
+    if (std::memcmp(header, signature, sizeof(signature)) != 0)
+    {
+        throw std::runtime_error{"not a PNG image"};
+    }
+
+    std::vector<uint8_t> chunk;
+    bool haveHeader{false};
+
+    // Chunk CRCs are not checked, zlib verifies its own checksum of the
+    // image data.
+
+    for (;;)
+    {
+        m_input.read(header, sizeof(header));
+        const auto length = bigEndian32(header);
+        const auto type = bigEndian32(header + 4);
+
+        if (length > 0x7FFFFFFF)
+        {
+            throw std::runtime_error{"bad PNG chunk length"};
+        }
+
+        if (type == 0x49444154) // IDAT
+        {
+            if (!haveHeader)
+            {
+                throw std::runtime_error{"PNG image data before header"};
+            }
+
+            inflateData(length);
+        }
+        else if (type == 0x49484452) // IHDR
+        {
+            // Lengths are checked before reading, so a bad one cannot
+            // ask for a huge buffer.
+
+            if (length != 13)
+            {
+                throw std::runtime_error{"bad PNG header"};
+            }
+
+            chunk.resize(length);
+            m_input.read(chunk.data(), length);
+            readHeader(chunk.data());
+            haveHeader = true;
+        }
+        else if (type == 0x504C5445) // PLTE
+        {
+            if (((length % 3) != 0) || (length > (256 * 3)))
+            {
+                throw std::runtime_error{"bad PNG palette"};
+            }
+
+            chunk.resize(length);
+            m_input.read(chunk.data(), length);
+            readPalette(chunk.data(), length);
+        }
+        else if (type == 0x49454E44) // IEND
+        {
+            break;
+        }
+        else
+        {
+            m_input.skip(length);
+        }
+
+        m_input.skip(4);
+    }
+
+    if ((!haveHeader) || (m_y < m_height))
+    {
+        throw std::runtime_error{"truncated PNG image"};
+    }
+
+    return std::move(m_image);
+}
+
+//-------------------------------------------------------------------------
+
+void
+PngDecoder:: readHeader(
+    const uint8_t* data)
+{
+    m_width = bigEndian32(data);
+    m_height = bigEndian32(data + 4);
+    m_bitDepth = data[8];
+    m_colourType = data[9];
+
+    int channels{0};
+
+    switch (m_colourType)
+    {
+    case 0:
+
+        channels = 1;
+        break;
+
+    case 2:
+
+        channels = 3;
+        break;
+
+    case 3:
+
+        channels = 1;
+        break;
+
+    case 4:
+
+        channels = 2;
+        break;
+
+    case 6:
+
+        channels = 4;
+        break;
+
+    default:
+
+        throw std::runtime_error{"bad PNG colour type"};
+    }
+
+    const bool validDepth =
+        (m_bitDepth == 8) ||
+        ((m_bitDepth == 16) && (m_colourType != 3)) ||
+        ((m_bitDepth < 8) &&
+         ((m_colourType == 0) || (m_colourType == 3)) &&
+         ((m_bitDepth == 1) || (m_bitDepth == 2) || (m_bitDepth == 4)));
+
+    if (!validDepth)
+    {
+        throw std::runtime_error{"bad PNG bit depth"};
+    }
+
+    if ((data[10] != 0) || (data[11] != 0))
+    {
+        throw std::runtime_error{"unsupported PNG compression or filter"};
+    }
+
+    if (data[12] != 0)
+    {
+        throw std::runtime_error{"interlaced PNG images are not supported"};
+    }
+
+    m_image = createImage(m_width, m_height, "PNG");
+
+    const size_t bits = size_t(channels) * m_bitDepth;
+    m_pixelBytes = std::max<size_t>(1, bits / 8);
+    m_rowBytes = ((m_width * bits) + 7) / 8;
+
+    m_row.assign(m_rowBytes + 1, 0);
+    m_previous.assign(m_rowBytes + 1, 0);
+    m_rgb.assign(size_t(m_width) * 3, 0);
+}
+
+//-------------------------------------------------------------------------
+
+void
+PngDecoder:: readPalette(
+    const uint8_t* data,
+    uint32_t length)
+{
+    // Indices past the end of the palette draw black.
+
+    m_palette.assign(256 * 3, 0);
+    std::copy(data, data + length, m_palette.begin());
+}
+
+//-------------------------------------------------------------------------
+
+void
+PngDecoder:: inflateData(
+    uint32_t length)
+{
+    while (length > 0)
+    {
+        auto available = std::min<size_t>(length, m_input.fill(length));
+
+        if (available == 0)
+        {
+            throw std::runtime_error{"unexpected end of image data"};
+        }
+
+        if (m_zstreamEnd || (m_y == m_height))
+        {
+            m_input.consume(available);
+            length -= available;
+            continue;
+        }
+
+        m_zstream.next_in = const_cast<uint8_t*>(m_input.data());
+        m_zstream.avail_in = available;
+
+        // Keep inflating while there is input, or while the last call
+        // filled a row and may have more output waiting.
+
+        bool rowDone{true};
+
+        while (((m_zstream.avail_in > 0) || rowDone) &&
+               (!m_zstreamEnd) &&
+               (m_y < m_height))
+        {
+            m_zstream.next_out = m_row.data() + m_filled;
+            m_zstream.avail_out = m_row.size() - m_filled;
+
+            auto result = inflate(&m_zstream, Z_NO_FLUSH);
+
+            if (result == Z_STREAM_END)
+            {
+                m_zstreamEnd = true;
+            }
+            else if (result == Z_BUF_ERROR)
+            {
+                break;
+            }
+            else if (result != Z_OK)
+            {
+                throw std::runtime_error{"bad PNG image data"};
+            }
+
+            m_filled = m_row.size() - m_zstream.avail_out;
+            rowDone = (m_filled == m_row.size());
+
+            if (rowDone)
+            {
+                unfilterRow();
+                convertRow();
+                m_row.swap(m_previous);
+                m_filled = 0;
+                ++m_y;
+            }
+        }
+
+        const size_t used = available - m_zstream.avail_in;
+        m_input.consume(used);
+        length -= used;
+
+        if ((m_zstreamEnd || (m_y == m_height)) && (used < available))
+        {
+            m_input.consume(available - used);
+            length -= available - used;
+        }
+    }
+}
+
+//-------------------------------------------------------------------------
+
+inline uint8_t
+paeth(
+    int a,
+    int b,
+    int c)
+{
+    const int p = a + b - c;
+    const int pa = std::abs(p - a);
+    const int pb = std::abs(p - b);
+    const int pc = std::abs(p - c);
+
+    if ((pa <= pb) && (pa <= pc))
+    {
+        return a;
+    }
+
+    return (pb <= pc) ? b : c;
+}
+
+//-------------------------------------------------------------------------
+
+void
+PngDecoder:: unfilterRow()
+{
+    // Both rows start with the filter type byte, so the pixels are from
+    // index 1, and the byte m_pixelBytes to the left of index i is at
+    // i - m_pixelBytes, which reads as 0 for the first pixel.
+
+    auto row = m_row.data() + 1;
+    auto up = m_previous.data() + 1;
+    const auto size = m_rowBytes;
+    const auto bpp = m_pixelBytes;
+
+    switch (m_row[0])
+    {
+    case 0:
+
+        break;
+
+    case 1:
+
+        for (size_t i = bpp ; i < size ; ++i)
+        {
+            row[i] += row[i - bpp];
+        }
+
+        break;
+
+    case 2:
+
+        for (size_t i = 0 ; i < size ; ++i)
+        {
+            row[i] += up[i];
+        }
+
+        break;
+
+    case 3:
+
+        for (size_t i = 0 ; i < bpp ; ++i)
+        {
+            row[i] += up[i] / 2;
+        }
+
+        for (size_t i = bpp ; i < size ; ++i)
+        {
+            row[i] += (row[i - bpp] + up[i]) / 2;
+        }
+
+        break;
+
+    case 4:
+
+        for (size_t i = 0 ; i < bpp ; ++i)
+        {
+            row[i] += up[i];
+        }
+
+        for (size_t i = bpp ; i < size ; ++i)
+        {
+            row[i] += paeth(row[i - bpp], up[i], up[i - bpp]);
+        }
+
+        break;
+
+    default:
+
+        throw std::runtime_error{"bad PNG filter type"};
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+PngDecoder:: convertRow()
+{
+    const auto row = m_row.data() + 1;
+    auto rgb = m_rgb.data();
+
+    if ((m_colourType == 3) && m_palette.empty())
+    {
+        throw std::runtime_error{"PNG image has no palette"};
+    }
+
+    if ((m_colourType == 2) && (m_bitDepth == 8))
+    {
+        rgb = row;
+    }
+    else if (m_bitDepth < 8)
+    {
+        const int perByte = 8 / m_bitDepth;
+        const int mask = (1 << m_bitDepth) - 1;
+        const int scale = 255 / mask;
+
+        for (uint32_t x = 0 ; x < m_width ; ++x)
+        {
+            const int shift = 8 - m_bitDepth * ((x % perByte) + 1);
+            const int value = (row[x / perByte] >> shift) & mask;
+            auto out = rgb + (x * 3);
+
+            if (m_colourType == 3)
+            {
+                std::copy_n(m_palette.data() + (value * 3), 3, out);
+            }
+            else
+            {
+                std::fill_n(out, 3, value * scale);
+            }
+        }
+    }
+    else
+    {
+        // 8 or 16 bits per sample, where only the most significant byte of
+        // a 16 bit sample is used.
+
+        const size_t step = m_bitDepth / 8;
+        const size_t pixelStep = m_pixelBytes;
+        auto in = row;
+
+        for (uint32_t x = 0 ; x < m_width ; ++x, in += pixelStep)
+        {
+            auto out = rgb + (x * 3);
+
+            switch (m_colourType)
+            {
+            case 0:
+            case 4:
+
+                std::fill_n(out, 3, in[0]);
+                break;
+
+            case 3:
+
+                std::copy_n(m_palette.data() + (in[0] * 3), 3, out);
+                break;
+
+            default:
+
+                out[0] = in[0];
+                out[1] = in[step];
+                out[2] = in[step * 2];
+                break;
+            }
+        }
+    }
+
+    convertRow888(rgb, m_image.getRow(m_y), m_width, m_y, m_dither);
+}
+
+#endif
+
+//-------------------------------------------------------------------------
+
+Image565
+decodePng(
+    InputBuffer& input,
+    Dither dither)
+{
+#ifdef RASPIFB16_ZLIB
+    PngDecoder decoder{input, dither};
+    return decoder.decode();
+#else
+    throw std::runtime_error{"PNG images need raspifb16 built with zlib"};
+#endif
+}
+
+//-------------------------------------------------------------------------
+
+} // namespace
+
+//-------------------------------------------------------------------------
+
+raspifb16::Image565
+raspifb16::decodePpm(
+    std::istream& input,
+    Dither dither)
+{
+    InputBuffer buffer{input};
+    return ::decodePpm(buffer, dither);
+}
+
+//-------------------------------------------------------------------------
+
+raspifb16::Image565
+raspifb16::decodeQoi(
+    std::istream& input,
+    Dither dither)
+{
+    InputBuffer buffer{input};
+    return ::decodeQoi(buffer, dither);
+}
+
+//-------------------------------------------------------------------------
+
+raspifb16::Image565
+raspifb16::decodePng(
+    std::istream& input,
+    Dither dither)
+{
+    InputBuffer buffer{input};
+    return ::decodePng(buffer, dither);
+}
+
+//-------------------------------------------------------------------------
+
+raspifb16::Image565
+raspifb16::decodeImage(
+    std::istream& input,
+    Dither dither)
+{
+    InputBuffer buffer{input};
+
+    if (buffer.fill(4) < 4)
+    {
+        throw std::runtime_error{"unrecognised image format"};
+    }
+
+    const auto magic = buffer.data();
+
+    if (std::memcmp(magic, "qoif", 4) == 0)
+    {
+        return ::decodeQoi(buffer, dither);
+    }
+    else if (std::memcmp(magic, "\x89PNG", 4) == 0)
+    {
+        return ::decodePng(buffer, dither);
+    }
+    else if ((magic[0] == 'P') && ((magic[1] == '5') || (magic[1] == '6')))
+    {
+        return ::decodePpm(buffer, dither);
+    }
+
+    throw std::runtime_error{"unrecognised image format"};
+}
+
+//-------------------------------------------------------------------------
+
+raspifb16::Image565
+raspifb16::loadImage(
+    const std::string& filename,
+    Dither dither)
+{
+    std::ifstream input{filename, std::ifstream::binary};
+
+    if (input.is_open() == false)
+    {
+        throw std::system_error{errno,
+                                std::system_category(),
+                                "unable to open " + filename};
+    }
+
+    return decodeImage(input, dither);
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::convertRow888(
+    const uint8_t* rgb,
+    uint16_t* row,
+    int32_t length,
+    int32_t y,
+    Dither dither,
+    int32_t x)
+{
+    if (dither == Dither::NONE)
+    {
+        for (int32_t i = 0 ; i < length ; ++i, rgb += 3)
+        {
+            row[i] = ((rgb[0] & 0xF8) << 8) |
+                     ((rgb[1] & 0xFC) << 3) |
+                     (rgb[2] >> 3);
+        }
+
+        return;
+    }
+
+    // The Bayer matrix holds 0 to 15. Scaled to less than one step of the
+    // 5 bit channels (8) and of the 6 bit channel (4), adding it before
+    // truncation rounds up in proportion to the part that would be lost.
+
+    static constexpr uint8_t bayer[4][4]
+    {
+        {  0,  8,  2, 10 },
+        { 12,  4, 14,  6 },
+        {  3, 11,  1,  9 },
+        { 15,  7, 13,  5 }
+    };
+
+    const auto thresholds = bayer[y & 3];
+
+    for (int32_t i = 0 ; i < length ; ++i, rgb += 3)
+    {
+        const int t = thresholds[(x + i) & 3];
+        const int r = std::min(rgb[0] + (t >> 1), 255);
+        const int g = std::min(rgb[1] + (t >> 2), 255);
+        const int b = std::min(rgb[2] + (t >> 1), 255);
+
+        row[i] = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+    }
+}
@@ -0,0 +1,91 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef IMAGE_DECODER_H
+#define IMAGE_DECODER_H
+
+//-------------------------------------------------------------------------
+
+#include <cstdint>
+#include <istream>
+#include <string>
+
+#include "image565.h"
+
+//-------------------------------------------------------------------------
+
+namespace raspifb16
+{
+
+//-------------------------------------------------------------------------
+
+// Decoders for PPM (P5 and P6), QOI and PNG images. Each one reads its
+// input in blocks and converts a row at a time straight into the
+// Image565, so there is never a 24 or 32 bit copy of the whole image.
+// Alpha is ignored. Malformed or unsupported input throws
+// std::runtime_error.
+//
+// Reducing 8 bit channels to 5 or 6 bits bands smooth gradients. ORDERED
+// adds a 4 x 4 Bayer threshold to each pixel before it is truncated,
+// which trades the bands for a fine regular pattern.
+
+enum class Dither { NONE, ORDERED };
+
+Image565 decodePpm(std::istream& input, Dither dither = Dither::NONE);
+Image565 decodeQoi(std::istream& input, Dither dither = Dither::NONE);
+
+// Only available when built with zlib, otherwise it always throws.
+
+Image565 decodePng(std::istream& input, Dither dither = Dither::NONE);
+
+// Choose the decoder from the first bytes of the input.
+
+Image565 decodeImage(std::istream& input, Dither dither = Dither::NONE);
+Image565 loadImage(const std::string& filename, Dither dither = Dither::NONE);
+
+//-------------------------------------------------------------------------
+
+// Convert length pixels of 8 bit red, green and blue from rgb to 565.
+// Row y and column x locate the pixels in the threshold pattern.
+
+void
+convertRow888(
+    const uint8_t* rgb,
+    uint16_t* row,
+    int32_t length,
+    int32_t y,
+    Dither dither,
+    int32_t x = 0);
+
+//-------------------------------------------------------------------------
+
+} // namespace raspifb16
+
+//-------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,183 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#include <utility>
+
+#include "imagePool.h"
+
+//-------------------------------------------------------------------------
+
+constexpr size_t raspifb16::ImagePool::sc_classes;
+
+//-------------------------------------------------------------------------
+
+raspifb16::ImagePool:: ImagePool(
+    size_t maxPerClass)
+:
+    m_maxPerClass{maxPerClass},
+    m_mutex{},
+    m_free{},
+    m_acquired{0},
+    m_reused{0},
+    m_released{0},
+    m_discarded{0}
+{
+    for (auto& images : m_free)
+    {
+        images.reserve(m_maxPerClass);
+    }
+}
+
+//-------------------------------------------------------------------------
+
+raspifb16::Image565
+raspifb16::ImagePool:: acquire(
+    int16_t width,
+    int16_t height,
+    Image565::Layout layout)
+{
+    Image565 image{0, 0};
+
+    auto pixels = static_cast<size_t>(Image565::stride(width, layout))
+                * height;
+    auto index = sizeClass(pixels);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        ++m_acquired;
+
+        auto& images = m_free[index];
+
+        if (!images.empty())
+        {
+            image = std::move(images.back());
+            images.pop_back();
+            ++m_reused;
+        }
+    }
+
+    if (image.getCapacity() < pixels)
+    {
+        image.reserve(size_t{1} << index);
+    }
+
+    image.reshape(width, height, layout);
+
+    return image;
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::ImagePool:: release(
+    Image565 image)
+{
+    auto capacity = image.getCapacity();
+
+    if (capacity == 0)
+    {
+        return;
+    }
+
+    // A buffer belongs to the largest class it can hold all of.
+
+    auto index = sizeClass(capacity);
+
+    if ((size_t{1} << index) > capacity)
+    {
+        --index;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    ++m_released;
+
+    auto& images = m_free[index];
+
+    if (images.size() < m_maxPerClass)
+    {
+        images.push_back(std::move(image));
+    }
+    else
+    {
+        ++m_discarded;
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::ImagePool:: clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (auto& images : m_free)
+    {
+        images.clear();
+    }
+}
+
+//-------------------------------------------------------------------------
+
+raspifb16::ImagePoolStatistics
+raspifb16::ImagePool:: getStatistics() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    size_t pooled{0};
+
+    for (const auto& images : m_free)
+    {
+        pooled += images.size();
+    }
+
+    return ImagePoolStatistics{m_acquired,
+                               m_reused,
+                               m_released,
+                               m_discarded,
+                               pooled};
+}
+
+//-------------------------------------------------------------------------
+
+size_t
+raspifb16::ImagePool:: sizeClass(
+    size_t pixels)
+{
+    // The smallest power of two that is at least pixels.
+
+    size_t index{0};
+
+    while ((index < (sc_classes - 1)) && ((size_t{1} << index) < pixels))
+    {
+        ++index;
+    }
+
+    return index;
+}
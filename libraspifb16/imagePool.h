@@ -0,0 +1,121 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef IMAGE_POOL_H
+#define IMAGE_POOL_H
+
+//-------------------------------------------------------------------------
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "image565.h"
+
+//-------------------------------------------------------------------------
+
+namespace raspifb16
+{
+
+//-------------------------------------------------------------------------
+
+struct ImagePoolStatistics
+{
+    uint64_t m_acquired;
+    uint64_t m_reused;
+    uint64_t m_released;
+    uint64_t m_discarded;
+    size_t m_pooled;
+};
+
+//-------------------------------------------------------------------------
+
+// Recycles Image565 buffers, so that temporary images (overlays, scaled
+// copies, snapshots) do not allocate new pixel buffers once the pool has
+// warmed up.
+//
+// Buffers are kept in size classes, each a power of two pixels. Any
+// buffer in a class can hold any image that needs that many pixels or
+// fewer (but more than half as many), so an acquired image need not be
+// the same shape as the one that was released.
+
+class ImagePool
+{
+public:
+
+    // At most maxPerClass buffers are kept in each size class, the rest
+    // are freed when they are released.
+
+    explicit ImagePool(size_t maxPerClass = 4);
+
+    ImagePool(const ImagePool&) = delete;
+    ImagePool& operator=(const ImagePool&) = delete;
+
+    // The pixels of the image returned are undefined.
+
+    Image565
+    acquire(
+        int16_t width,
+        int16_t height,
+        Image565::Layout layout = Image565::Layout::PACKED);
+
+    // The image is taken whether its buffer is kept or freed, so the
+    // caller is always left with an empty one.
+
+    void release(Image565 image);
+
+    void clear();
+
+    ImagePoolStatistics getStatistics() const;
+
+private:
+
+    static constexpr size_t sc_classes{32};
+
+    static size_t sizeClass(size_t pixels);
+
+    size_t m_maxPerClass;
+
+    mutable std::mutex m_mutex;
+    std::array<std::vector<Image565>, sc_classes> m_free;
+
+    uint64_t m_acquired;
+    uint64_t m_reused;
+    uint64_t m_released;
+    uint64_t m_discarded;
+};
+
+//-------------------------------------------------------------------------
+
+} // namespace raspifb16
+
+//-------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,289 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+#include "fileDescriptor.h"
+#include "mappedImage565.h"
+
+//-------------------------------------------------------------------------
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
+              ".i565 pixels are used in place, so must be little endian");
+
+constexpr size_t raspifb16::MappedImage565::sc_headerSize;
+constexpr uint16_t raspifb16::MappedImage565::sc_version;
+
+//-------------------------------------------------------------------------
+
+namespace
+{
+
+//-------------------------------------------------------------------------
+
+template<typename T>
+T
+readHeader(
+    const uint8_t* header,
+    size_t offset)
+{
+    T value;
+    std::memcpy(&value, header + offset, sizeof(T));
+    return value;
+}
+
+//-------------------------------------------------------------------------
+
+template<typename T>
+void
+writeHeader(
+    uint8_t* header,
+    size_t offset,
+    T value)
+{
+    std::memcpy(header + offset, &value, sizeof(T));
+}
+
+//-------------------------------------------------------------------------
+
+} // namespace
+
+//-------------------------------------------------------------------------
+
+raspifb16::MappedImage565:: MappedImage565(
+    const std::string& filename)
+:
+    m_map{MAP_FAILED},
+    m_length{0},
+    m_width{0},
+    m_height{0},
+    m_encoding{Encoding::RAW},
+    m_pixels{nullptr},
+    m_stride{0},
+    m_rle()
+{
+    FileDescriptor fd{::open(filename.c_str(), O_RDONLY)};
+
+    if (fd.fd() == -1)
+    {
+        throw std::system_error{errno,
+                                std::system_category(),
+                                "unable to open " + filename};
+    }
+
+    struct stat status;
+
+    if (::fstat(fd.fd(), &status) == -1)
+    {
+        throw std::system_error{errno,
+                                std::system_category(),
+                                "unable to stat " + filename};
+    }
+
+    m_length = status.st_size;
+
+    if (m_length < sc_headerSize)
+    {
+        throw std::runtime_error{filename + " is not a .i565 file"};
+    }
+
+    m_map = ::mmap(nullptr,
+                   m_length,
+                   PROT_READ,
+                   MAP_SHARED,
+                   fd.fd(),
+                   0);
+
+    if (m_map == MAP_FAILED)
+    {
+        throw std::system_error{errno,
+                                std::system_category(),
+                                "mapping " + filename + " to memory"};
+    }
+
+    try
+    {
+        auto header = static_cast<const uint8_t*>(m_map);
+
+        const auto version = readHeader<uint16_t>(header, 4);
+        const auto encoding = readHeader<uint16_t>(header, 6);
+        const auto width = readHeader<uint16_t>(header, 8);
+        const auto height = readHeader<uint16_t>(header, 10);
+        const auto stride = readHeader<uint32_t>(header, 12);
+        const auto offset = readHeader<uint32_t>(header, 16);
+        const auto size = readHeader<uint32_t>(header, 20);
+
+        if ((std::memcmp(header, "i565", 4) != 0) ||
+            (version != sc_version) ||
+            (encoding > 1) ||
+            (width > 32767) ||
+            (height > 32767) ||
+            (offset < sc_headerSize) ||
+            ((offset % sizeof(uint16_t)) != 0) ||
+            (offset > m_length) ||
+            (size > (m_length - offset)))
+        {
+            throw std::runtime_error{filename + " has a bad .i565 header"};
+        }
+
+        m_width = width;
+        m_height = height;
+        auto pixels = reinterpret_cast<const uint16_t*>(header + offset);
+
+        if (encoding == 0)
+        {
+            // In 64 bits, so a huge stride cannot wrap around to pass on
+            // a 32 bit system.
+
+            const uint64_t needed = (height == 0)
+                                  ? 0
+                                  : (uint64_t(stride) * (height - 1)) + width;
+
+            if ((stride < width) ||
+                (stride > 32767) ||
+                ((needed * sizeof(uint16_t)) > uint64_t(size)))
+            {
+                throw std::runtime_error{filename +
+                                         " has too little pixel data"};
+            }
+
+            m_pixels = pixels;
+            m_stride = stride;
+        }
+        else
+        {
+            m_encoding = Encoding::RLE;
+            m_rle.reset(new Rle565{
+                m_width,
+                m_height,
+                std::vector<uint16_t>(pixels,
+                                      pixels + (size / sizeof(uint16_t)))});
+
+            ::munmap(m_map, m_length);
+            m_map = MAP_FAILED;
+        }
+    }
+    catch (...)
+    {
+        if (m_map != MAP_FAILED)
+        {
+            ::munmap(m_map, m_length);
+        }
+
+        throw;
+    }
+}
+
+//-------------------------------------------------------------------------
+
+raspifb16::MappedImage565:: ~MappedImage565()
+{
+    if (m_map != MAP_FAILED)
+    {
+        ::munmap(m_map, m_length);
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::MappedImage565:: write(
+    const std::string& filename,
+    const Image565& image,
+    Encoding encoding)
+{
+    std::vector<uint16_t> runs;
+    uint32_t stride{0};
+    uint32_t size{0};
+
+    if (encoding == Encoding::RAW)
+    {
+        stride = image.getWidth();
+        size = image.getWidth() * image.getHeight() * sizeof(uint16_t);
+    }
+    else
+    {
+        runs = Rle565{image}.getData();
+        size = runs.size() * sizeof(uint16_t);
+    }
+
+    uint8_t header[sc_headerSize]{};
+
+    std::memcpy(header, "i565", 4);
+    writeHeader<uint16_t>(header, 4, sc_version);
+    writeHeader<uint16_t>(header, 6, (encoding == Encoding::RAW) ? 0 : 1);
+    writeHeader<uint16_t>(header, 8, image.getWidth());
+    writeHeader<uint16_t>(header, 10, image.getHeight());
+    writeHeader<uint32_t>(header, 12, stride);
+    writeHeader<uint32_t>(header, 16, sc_headerSize);
+    writeHeader<uint32_t>(header, 20, size);
+
+    std::ofstream output{filename, std::ofstream::binary};
+
+    if (output.is_open() == false)
+    {
+        throw std::system_error{errno,
+                                std::system_category(),
+                                "unable to create " + filename};
+    }
+
+    output.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+    if (encoding == Encoding::RAW)
+    {
+        // Rows are written packed, whatever the layout of the image.
+
+        for (int16_t j = 0 ; j < image.getHeight() ; ++j)
+        {
+            output.write(reinterpret_cast<const char*>(image.getRow(j)),
+                         image.getWidth() * sizeof(uint16_t));
+        }
+    }
+    else
+    {
+        output.write(reinterpret_cast<const char*>(runs.data()), size);
+    }
+
+    output.close();
+
+    if (output.fail())
+    {
+        throw std::system_error{errno,
+                                std::system_category(),
+                                "unable to write " + filename};
+    }
+}
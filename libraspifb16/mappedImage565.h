@@ -0,0 +1,129 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef MAPPED_IMAGE565_H
+#define MAPPED_IMAGE565_H
+
+//-------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "image565.h"
+#include "rle565.h"
+
+//-------------------------------------------------------------------------
+
+namespace raspifb16
+{
+
+//-------------------------------------------------------------------------
+
+// An image stored in a .i565 file, ready to draw with no decoding. A raw
+// file is mapped into memory and its pixels are used where they are, so
+// loading one costs little more than opening it, and putImage() reads
+// straight from the page cache. The mapping is read only, so the pixels
+// can be drawn from but not into.
+//
+// The file starts with a 64 byte header, in little endian order:
+//
+//    0  "i565"
+//    4  uint16_t  version (1)
+//    6  uint16_t  encoding (0 raw, 1 run length encoded)
+//    8  uint16_t  width
+//   10  uint16_t  height
+//   12  uint32_t  stride in pixels (raw only)
+//   16  uint32_t  offset of the pixel data from the start of the file
+//   20  uint32_t  size of the pixel data in bytes
+//
+// Raw pixel data is height rows of stride RGB565 pixels. Run length
+// encoded data is the words of an Rle565, which are small enough to be
+// copied into one when the file is opened.
+
+class MappedImage565
+{
+public:
+
+    enum class Encoding { RAW, RLE };
+
+    explicit MappedImage565(const std::string& filename);
+    ~MappedImage565();
+
+    MappedImage565(const MappedImage565&) = delete;
+    MappedImage565& operator=(const MappedImage565&) = delete;
+
+    int16_t getWidth() const { return m_width; }
+    int16_t getHeight() const { return m_height; }
+    Encoding getEncoding() const { return m_encoding; }
+
+    // Row y (0 to height - 1) of a raw file, straight from the mapping,
+    // with rows stride pixels apart. nullptr for a run length encoded
+    // file.
+
+    const uint16_t*
+    getRow(int16_t y) const
+    {
+        return (m_pixels) ? m_pixels + (y * m_stride) : nullptr;
+    }
+
+    int32_t getStride() const { return m_stride; }
+
+    // The runs of a run length encoded file, or nullptr for a raw one.
+
+    const Rle565* getRle() const { return m_rle.get(); }
+
+    static void
+    write(
+        const std::string& filename,
+        const Image565& image,
+        Encoding encoding = Encoding::RAW);
+
+private:
+
+    static constexpr size_t sc_headerSize{64};
+    static constexpr uint16_t sc_version{1};
+
+    void* m_map;
+    size_t m_length;
+    int16_t m_width;
+    int16_t m_height;
+    Encoding m_encoding;
+    const uint16_t* m_pixels;
+    int32_t m_stride;
+    std::unique_ptr<Rle565> m_rle;
+};
+
+//-------------------------------------------------------------------------
+
+} // namespace raspifb16
+
+//-------------------------------------------------------------------------
+
+#endif
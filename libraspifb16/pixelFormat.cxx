@@ -0,0 +1,147 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#include <stdexcept>
+
+#include "pixelFormat.h"
+
+//-------------------------------------------------------------------------
+
+namespace
+{
+
+//-------------------------------------------------------------------------
+
+using namespace raspifb16;
+
+template<typename Format>
+constexpr PixelKernels
+makeKernels(
+    PixelFormat format)
+{
+    return PixelKernels
+    {
+        format,
+        Format::bytesPerPixel,
+        writeRow<Format>,
+        readRow<Format>,
+        fillRow<Format>
+    };
+}
+
+const PixelKernels kernels[] =
+{
+    makeKernels<RGB565Format>(PixelFormat::RGB565),
+    makeKernels<BGR565Format>(PixelFormat::BGR565),
+    makeKernels<RGB888Format>(PixelFormat::RGB888),
+    makeKernels<XRGB8888Format>(PixelFormat::XRGB8888),
+    makeKernels<ARGB8888Format>(PixelFormat::ARGB8888)
+};
+
+//-------------------------------------------------------------------------
+
+bool
+matches(
+    const struct fb_bitfield& field,
+    uint32_t offset,
+    uint32_t length)
+{
+    return (field.offset == offset) && (field.length == length);
+}
+
+//-------------------------------------------------------------------------
+
+} // namespace
+
+//-------------------------------------------------------------------------
+
+raspifb16::PixelFormat
+raspifb16::pixelFormat(
+    const struct fb_var_screeninfo& vinfo)
+{
+    switch (vinfo.bits_per_pixel)
+    {
+    case 16:
+
+        if (matches(vinfo.red, 11, 5) &&
+            matches(vinfo.green, 5, 6) &&
+            matches(vinfo.blue, 0, 5))
+        {
+            return PixelFormat::RGB565;
+        }
+
+        if (matches(vinfo.red, 0, 5) &&
+            matches(vinfo.green, 5, 6) &&
+            matches(vinfo.blue, 11, 5))
+        {
+            return PixelFormat::BGR565;
+        }
+
+        break;
+
+    case 24:
+
+        if (matches(vinfo.red, 16, 8) &&
+            matches(vinfo.green, 8, 8) &&
+            matches(vinfo.blue, 0, 8))
+        {
+            return PixelFormat::RGB888;
+        }
+
+        break;
+
+    case 32:
+
+        if (matches(vinfo.red, 16, 8) &&
+            matches(vinfo.green, 8, 8) &&
+            matches(vinfo.blue, 0, 8))
+        {
+            if (vinfo.transp.length == 8)
+            {
+                return PixelFormat::ARGB8888;
+            }
+
+            return PixelFormat::XRGB8888;
+        }
+
+        break;
+    }
+
+    throw std::invalid_argument{"unsupported framebuffer pixel format ("
+                                + std::to_string(vinfo.bits_per_pixel)
+                                + " bits per pixel)"};
+}
+
+//-------------------------------------------------------------------------
+
+const raspifb16::PixelKernels&
+raspifb16::pixelKernels(
+    PixelFormat format)
+{
+    return kernels[static_cast<int>(format)];
+}
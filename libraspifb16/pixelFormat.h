@@ -0,0 +1,328 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef PIXEL_FORMAT_H
+#define PIXEL_FORMAT_H
+
+//-------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <linux/fb.h>
+
+#include "convert565.h"
+
+//-------------------------------------------------------------------------
+
+namespace raspifb16
+{
+
+//-------------------------------------------------------------------------
+
+enum class PixelFormat { RGB565, BGR565, RGB888, XRGB8888, ARGB8888 };
+
+//-------------------------------------------------------------------------
+
+// Pixel format policies. Each one knows how to store an RGB565 value in
+// framebuffer memory and how to load it back again. Multi-byte values are
+// in the (little endian) byte order used by the framebuffer.
+
+struct RGB565Format
+{
+    static constexpr size_t bytesPerPixel{2};
+
+    static void
+    store(uint8_t* p, uint16_t rgb)
+    {
+        std::memcpy(p, &rgb, sizeof(rgb));
+    }
+
+    static uint16_t
+    load(const uint8_t* p)
+    {
+        uint16_t rgb;
+        std::memcpy(&rgb, p, sizeof(rgb));
+
+        return rgb;
+    }
+};
+
+struct BGR565Format
+{
+    static constexpr size_t bytesPerPixel{2};
+
+    static uint16_t
+    swap(uint16_t rgb)
+    {
+        return (rgb & 0x07E0) | (rgb >> 11) | (rgb << 11);
+    }
+
+    static void
+    store(uint8_t* p, uint16_t rgb)
+    {
+        RGB565Format::store(p, swap(rgb));
+    }
+
+    static uint16_t
+    load(const uint8_t* p)
+    {
+        return swap(RGB565Format::load(p));
+    }
+};
+
+struct RGB888Format
+{
+    static constexpr size_t bytesPerPixel{3};
+
+    static void
+    store(uint8_t* p, uint16_t rgb)
+    {
+        uint8_t r5 = (rgb >> 11) & 0x1F;
+        uint8_t g6 = (rgb >> 5) & 0x3F;
+        uint8_t b5 = rgb & 0x1F;
+
+        p[0] = (b5 << 3) | (b5 >> 2);
+        p[1] = (g6 << 2) | (g6 >> 4);
+        p[2] = (r5 << 3) | (r5 >> 2);
+    }
+
+    static uint16_t
+    load(const uint8_t* p)
+    {
+        return ((p[2] >> 3) << 11) | ((p[1] >> 2) << 5) | (p[0] >> 3);
+    }
+};
+
+struct XRGB8888Format
+{
+    static constexpr size_t bytesPerPixel{4};
+    static constexpr uint32_t alpha{0};
+
+    static uint32_t
+    expand(uint16_t rgb)
+    {
+        uint32_t r5 = (rgb >> 11) & 0x1F;
+        uint32_t g6 = (rgb >> 5) & 0x3F;
+        uint32_t b5 = rgb & 0x1F;
+
+        return (((r5 << 3) | (r5 >> 2)) << 16)
+             | (((g6 << 2) | (g6 >> 4)) << 8)
+             | ((b5 << 3) | (b5 >> 2));
+    }
+
+    static void
+    store(uint8_t* p, uint16_t rgb)
+    {
+        uint32_t argb = expand(rgb) | alpha;
+        std::memcpy(p, &argb, sizeof(argb));
+    }
+
+    static uint16_t
+    load(const uint8_t* p)
+    {
+        uint32_t argb;
+        std::memcpy(&argb, p, sizeof(argb));
+
+        return ((argb >> 8) & 0xF800)
+             | ((argb >> 5) & 0x07E0)
+             | ((argb >> 3) & 0x001F);
+    }
+};
+
+struct ARGB8888Format
+:
+    public XRGB8888Format
+{
+    static constexpr uint32_t alpha{0xFF000000};
+
+    static void
+    store(uint8_t* p, uint16_t rgb)
+    {
+        uint32_t argb = expand(rgb) | alpha;
+        std::memcpy(p, &argb, sizeof(argb));
+    }
+};
+
+//-------------------------------------------------------------------------
+
+// Row conversion kernels, instantiated once for each pixel format so the
+// inner loops have no per-pixel dispatch.
+
+template<typename Format>
+void
+writeRow(
+    uint8_t* dst,
+    const uint16_t* src,
+    size_t length)
+{
+    for (size_t i = 0 ; i < length ; ++i)
+    {
+        Format::store(dst, src[i]);
+        dst += Format::bytesPerPixel;
+    }
+}
+
+template<typename Format>
+void
+readRow(
+    uint16_t* dst,
+    const uint8_t* src,
+    size_t length)
+{
+    for (size_t i = 0 ; i < length ; ++i)
+    {
+        dst[i] = Format::load(src);
+        src += Format::bytesPerPixel;
+    }
+}
+
+template<typename Format>
+void
+fillRow(
+    uint8_t* dst,
+    uint16_t rgb,
+    size_t length)
+{
+    uint8_t pixel[Format::bytesPerPixel];
+    Format::store(pixel, rgb);
+
+    for (size_t i = 0 ; i < length ; ++i)
+    {
+        std::memcpy(dst, pixel, Format::bytesPerPixel);
+        dst += Format::bytesPerPixel;
+    }
+}
+
+template<>
+inline void
+writeRow<RGB565Format>(
+    uint8_t* dst,
+    const uint16_t* src,
+    size_t length)
+{
+    std::memcpy(dst, src, length * RGB565Format::bytesPerPixel);
+}
+
+template<>
+inline void
+readRow<RGB565Format>(
+    uint16_t* dst,
+    const uint8_t* src,
+    size_t length)
+{
+    std::memcpy(dst, src, length * RGB565Format::bytesPerPixel);
+}
+
+// The 24 and 32 bit formats convert whole rows with the vector kernels.
+
+template<>
+inline void
+writeRow<RGB888Format>(
+    uint8_t* dst,
+    const uint16_t* src,
+    size_t length)
+{
+    rgb565ToRgb888(dst, src, length);
+}
+
+template<>
+inline void
+readRow<RGB888Format>(
+    uint16_t* dst,
+    const uint8_t* src,
+    size_t length)
+{
+    rgb888ToRgb565(dst, src, length);
+}
+
+template<>
+inline void
+writeRow<XRGB8888Format>(
+    uint8_t* dst,
+    const uint16_t* src,
+    size_t length)
+{
+    rgb565ToXrgb8888(dst, src, length, XRGB8888Format::alpha >> 24);
+}
+
+template<>
+inline void
+readRow<XRGB8888Format>(
+    uint16_t* dst,
+    const uint8_t* src,
+    size_t length)
+{
+    xrgb8888ToRgb565(dst, src, length);
+}
+
+template<>
+inline void
+writeRow<ARGB8888Format>(
+    uint8_t* dst,
+    const uint16_t* src,
+    size_t length)
+{
+    rgb565ToXrgb8888(dst, src, length, ARGB8888Format::alpha >> 24);
+}
+
+template<>
+inline void
+readRow<ARGB8888Format>(
+    uint16_t* dst,
+    const uint8_t* src,
+    size_t length)
+{
+    xrgb8888ToRgb565(dst, src, length);
+}
+
+//-------------------------------------------------------------------------
+
+struct PixelKernels
+{
+    PixelFormat m_format;
+    size_t m_bytesPerPixel;
+    void (*m_writeRow)(uint8_t* dst, const uint16_t* src, size_t length);
+    void (*m_readRow)(uint16_t* dst, const uint8_t* src, size_t length);
+    void (*m_fillRow)(uint8_t* dst, uint16_t rgb, size_t length);
+};
+
+//-------------------------------------------------------------------------
+
+PixelFormat pixelFormat(const struct fb_var_screeninfo& vinfo);
+
+const PixelKernels& pixelKernels(PixelFormat format);
+
+//-------------------------------------------------------------------------
+
+} // namespace raspifb16
+
+//-------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,331 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#include <algorithm>
+
+#include "presenter.h"
+
+//-------------------------------------------------------------------------
+
+raspifb16::Presenter:: Presenter(
+    FrameBuffer565& fb,
+    size_t queueLength)
+:
+    m_queueLength{queueLength},
+    m_targets{}
+{
+    addTarget(fb);
+}
+
+//-------------------------------------------------------------------------
+
+raspifb16::Presenter:: ~Presenter() = default;
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::Presenter:: addTarget(
+    FrameBuffer565& fb)
+{
+    m_targets.push_back(std::make_unique<Target>(fb, m_queueLength));
+}
+
+//-------------------------------------------------------------------------
+
+bool
+raspifb16::Presenter:: submit(
+    const FB565Point& p,
+    const Image565& image)
+{
+    bool result = true;
+
+    for (auto& target : m_targets)
+    {
+        result = target->submit(p, image) && result;
+    }
+
+    return result;
+}
+
+//-------------------------------------------------------------------------
+
+bool
+raspifb16::Presenter:: present()
+{
+    bool result = true;
+
+    for (auto& target : m_targets)
+    {
+        result = target->present() && result;
+    }
+
+    return result;
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::Presenter:: waitForIdle()
+{
+    for (auto& target : m_targets)
+    {
+        target->waitForIdle();
+    }
+}
+
+//-------------------------------------------------------------------------
+
+raspifb16::PresenterStatistics
+raspifb16::Presenter:: getStatistics(
+    size_t target) const
+{
+    return m_targets.at(target)->getStatistics();
+}
+
+//-------------------------------------------------------------------------
+
+raspifb16::Presenter::Target:: Target(
+    FrameBuffer565& fb,
+    size_t queueLength)
+:
+    m_fb(fb),
+    m_queue{queueLength},
+    m_mutex{},
+    m_wakeUp{},
+    m_idle{},
+    m_busy{false},
+    m_running{true},
+    m_submitted{0},
+    m_written{0},
+    m_stale{0},
+    m_rejected{0},
+    m_presents{0},
+    m_maxQueueDepth{0},
+    m_thread{}
+{
+    m_thread = std::thread(&Target::run, this);
+}
+
+//-------------------------------------------------------------------------
+
+raspifb16::Presenter::Target:: ~Target()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running = false;
+    }
+
+    m_wakeUp.notify_one();
+    m_thread.join();
+}
+
+//-------------------------------------------------------------------------
+
+bool
+raspifb16::Presenter::Target:: submit(
+    const FB565Point& p,
+    const Image565& image)
+{
+    ++m_submitted;
+
+    auto item = m_queue.back();
+
+    if (item == nullptr)
+    {
+        ++m_rejected;
+        return false;
+    }
+
+    // Assigning to the slot reuses its buffer when the size matches.
+
+    item->m_present = false;
+    item->m_position = p;
+    item->m_image = image;
+
+    m_queue.push();
+    notify();
+
+    return true;
+}
+
+//-------------------------------------------------------------------------
+
+bool
+raspifb16::Presenter::Target:: present()
+{
+    auto item = m_queue.back();
+
+    if (item == nullptr)
+    {
+        ++m_rejected;
+        return false;
+    }
+
+    item->m_present = true;
+
+    m_queue.push();
+    notify();
+
+    return true;
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::Presenter::Target:: waitForIdle()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_idle.wait(lock, [this] { return !m_busy && m_queue.empty(); });
+}
+
+//-------------------------------------------------------------------------
+
+raspifb16::PresenterStatistics
+raspifb16::Presenter::Target:: getStatistics() const
+{
+    return PresenterStatistics
+    {
+        m_submitted,
+        m_written,
+        m_stale,
+        m_rejected,
+        m_presents,
+        m_queue.size(),
+        m_maxQueueDepth
+    };
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::Presenter::Target:: notify()
+{
+    auto depth = m_queue.size();
+
+    if (depth > m_maxQueueDepth)
+    {
+        m_maxQueueDepth = depth;
+    }
+
+    // Taking the lock means the presenter thread is either waiting or has
+    // yet to check the queue, so the notification cannot be lost.
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+    }
+
+    m_wakeUp.notify_one();
+}
+
+//-------------------------------------------------------------------------
+
+bool
+raspifb16::Presenter::Target:: isStale(
+    size_t index)
+{
+    auto item = m_queue.at(index);
+
+    // Only an image from the same frame can replace this one. A later
+    // frame may not be complete yet, and this frame is shown without it.
+
+    for (auto later = m_queue.at(++index) ;
+         (later != nullptr) && !later->m_present ;
+         later = m_queue.at(++index))
+    {
+        if ((later->m_position.x() == item->m_position.x()) &&
+            (later->m_position.y() == item->m_position.y()) &&
+            (later->m_image.getWidth() == item->m_image.getWidth()) &&
+            (later->m_image.getHeight() == item->m_image.getHeight()))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::Presenter::Target:: run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true)
+    {
+        m_busy = false;
+        m_idle.notify_all();
+
+        m_wakeUp.wait(lock, [this] { return !m_running || !m_queue.empty(); });
+
+        if (m_queue.empty())
+        {
+            break;
+        }
+
+        m_busy = true;
+        lock.unlock();
+
+        for (auto item = m_queue.front() ;
+             item != nullptr ;
+             item = m_queue.front())
+        {
+            if (item->m_present)
+            {
+                bool newerFrame = false;
+
+                for (size_t i = 1 ; m_queue.at(i) != nullptr ; ++i)
+                {
+                    newerFrame = newerFrame || m_queue.at(i)->m_present;
+                }
+
+                // No point showing this frame if the next is complete.
+
+                if (!newerFrame)
+                {
+                    m_fb.present();
+                    ++m_presents;
+                }
+            }
+            else if (isStale(0))
+            {
+                ++m_stale;
+            }
+            else
+            {
+                m_fb.putImage(item->m_position, item->m_image);
+                ++m_written;
+            }
+
+            m_queue.pop();
+        }
+
+        lock.lock();
+    }
+}
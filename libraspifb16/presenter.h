@@ -0,0 +1,169 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef PRESENTER_H
+#define PRESENTER_H
+
+//-------------------------------------------------------------------------
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "framebuffer565.h"
+#include "image565.h"
+#include "spscQueue.h"
+
+//-------------------------------------------------------------------------
+
+namespace raspifb16
+{
+
+//-------------------------------------------------------------------------
+
+struct PresenterStatistics
+{
+    uint64_t m_submitted;
+    uint64_t m_written;
+    uint64_t m_stale;
+    uint64_t m_rejected;
+    uint64_t m_presents;
+    size_t m_queueDepth;
+    size_t m_maxQueueDepth;
+};
+
+//-------------------------------------------------------------------------
+
+// Copies images to a framebuffer on a thread of its own, so that a slow
+// framebuffer does not hold up the thread rendering the images.
+//
+// The rendering thread calls submit() for each image (a whole frame or
+// just the region that changed) and then present(). Images are copied
+// into a lock-free queue. If an image is still queued when a newer one
+// of the same size and position arrives for the same frame (before the
+// next present()), the older one is stale and is never written. If the
+// queue is full, submit() rejects the image.
+//
+// More framebuffers can be added with addTarget() to show the same
+// images on each of them. Every target has its own queue and thread, so
+// a slow target (an SPI display, say) never holds back a fast one. Each
+// framebuffer converts to its own pixel format and flushes in present().
+//
+// While a Presenter exists, only its threads should use the framebuffers.
+
+class Presenter
+{
+public:
+
+    explicit Presenter(FrameBuffer565& fb, size_t queueLength = 16);
+    ~Presenter();
+
+    Presenter(const Presenter&) = delete;
+    Presenter& operator= (const Presenter&) = delete;
+
+    void addTarget(FrameBuffer565& fb);
+    size_t getTargetCount() const { return m_targets.size(); }
+
+    // Return false if any target rejected the image.
+
+    bool submit(const FB565Point& p, const Image565& image);
+    bool present();
+
+    // Block until everything submitted so far has been written.
+
+    void waitForIdle();
+
+    PresenterStatistics getStatistics(size_t target = 0) const;
+
+private:
+
+    struct Item
+    {
+        Item() : m_present{false}, m_position{0, 0}, m_image{0, 0} { }
+
+        bool m_present;
+        FB565Point m_position;
+        Image565 m_image;
+    };
+
+    class Target
+    {
+    public:
+
+        Target(FrameBuffer565& fb, size_t queueLength);
+        ~Target();
+
+        Target(const Target&) = delete;
+        Target& operator= (const Target&) = delete;
+
+        bool submit(const FB565Point& p, const Image565& image);
+        bool present();
+        void waitForIdle();
+
+        PresenterStatistics getStatistics() const;
+
+    private:
+
+        void run();
+        bool isStale(size_t index);
+        void notify();
+
+        FrameBuffer565& m_fb;
+        SpscQueue<Item> m_queue;
+
+        std::mutex m_mutex;
+        std::condition_variable m_wakeUp;
+        std::condition_variable m_idle;
+        bool m_busy;
+        bool m_running;
+
+        std::atomic<uint64_t> m_submitted;
+        std::atomic<uint64_t> m_written;
+        std::atomic<uint64_t> m_stale;
+        std::atomic<uint64_t> m_rejected;
+        std::atomic<uint64_t> m_presents;
+        std::atomic<size_t> m_maxQueueDepth;
+
+        std::thread m_thread;
+    };
+
+    size_t m_queueLength;
+    std::vector<std::unique_ptr<Target>> m_targets;
+};
+
+//-------------------------------------------------------------------------
+
+} // namespace raspifb16
+
+//-------------------------------------------------------------------------
+
+#endif
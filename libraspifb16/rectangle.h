@@ -0,0 +1,113 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef RECTANGLE_H
+#define RECTANGLE_H
+
+//-------------------------------------------------------------------------
+
+#include <algorithm>
+
+#include "point.h"
+
+//-------------------------------------------------------------------------
+
+namespace raspifb16
+{
+
+//-------------------------------------------------------------------------
+
+template<typename T>
+class Rectangle
+{
+public:
+
+    Rectangle(
+        T x,
+        T y,
+        T width,
+        T height)
+    :
+        m_x(x),
+        m_y(y),
+        m_width(width),
+        m_height(height)
+    {
+    }
+
+    Rectangle(
+        const Point<T>& topLeft,
+        T width,
+        T height)
+    :
+        Rectangle(topLeft.x(), topLeft.y(), width, height)
+    {
+    }
+
+    T x() const { return m_x; }
+    T y() const { return m_y; }
+    T width() const { return m_width; }
+    T height() const { return m_height; }
+
+    // One past the right and bottom edges.
+
+    T right() const { return m_x + m_width; }
+    T bottom() const { return m_y + m_height; }
+
+    bool empty() const { return (m_width <= 0) || (m_height <= 0); }
+
+    Rectangle
+    intersection(
+        const Rectangle& other) const
+    {
+        T left = std::max(m_x, other.m_x);
+        T top = std::max(m_y, other.m_y);
+        T right = std::min(this->right(), other.right());
+        T bottom = std::min(this->bottom(), other.bottom());
+
+        return Rectangle(left,
+                         top,
+                         std::max<T>(right - left, 0),
+                         std::max<T>(bottom - top, 0));
+    }
+
+private:
+
+    T m_x;
+    T m_y;
+    T m_width;
+    T m_height;
+};
+
+//-------------------------------------------------------------------------
+
+} // namespace raspifb16
+
+//-------------------------------------------------------------------------
+
+#endif
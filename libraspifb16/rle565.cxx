@@ -0,0 +1,234 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include "rle565.h"
+
+//-------------------------------------------------------------------------
+
+constexpr uint16_t raspifb16::Rle565::sc_literal;
+constexpr int32_t raspifb16::Rle565::sc_maxRun;
+constexpr int32_t raspifb16::Rle565::sc_minFill;
+
+//-------------------------------------------------------------------------
+
+raspifb16::Rle565:: Rle565(
+    const Image565& image)
+:
+    m_width{image.getWidth()},
+    m_height{image.getHeight()},
+    m_data(),
+    m_rows()
+{
+    m_rows.reserve(m_height + 1);
+
+    for (int16_t j = 0 ; j < m_height ; ++j)
+    {
+        m_rows.push_back(m_data.size());
+        encodeRow(image.getRow(j));
+    }
+
+    m_rows.push_back(m_data.size());
+    m_data.shrink_to_fit();
+}
+
+//-------------------------------------------------------------------------
+
+raspifb16::Rle565:: Rle565(
+    int16_t width,
+    int16_t height,
+    std::vector<uint16_t> data)
+:
+    m_width{width},
+    m_height{height},
+    m_data(std::move(data)),
+    m_rows()
+{
+    m_rows.reserve(m_height + 1);
+
+    size_t i{0};
+
+    for (int16_t j = 0 ; j < m_height ; ++j)
+    {
+        m_rows.push_back(i);
+
+        int32_t x{0};
+
+        while ((x < m_width) && (i < m_data.size()))
+        {
+            bool literal = (m_data[i] & sc_literal) != 0;
+            int32_t length = m_data[i] & ~sc_literal;
+
+            i += (literal) ? length + 1 : 2;
+            x += length;
+        }
+
+        if ((x != m_width) || (i > m_data.size()))
+        {
+            throw std::invalid_argument{"bad Rle565 run data"};
+        }
+    }
+
+    if (i != m_data.size())
+    {
+        throw std::invalid_argument{"bad Rle565 run data"};
+    }
+
+    m_rows.push_back(i);
+}
+
+//-------------------------------------------------------------------------
+
+raspifb16::Image565
+raspifb16::Rle565:: decode() const
+{
+    Image565 image{m_width, m_height};
+
+    for (int16_t j = 0 ; j < m_height ; ++j)
+    {
+        auto row = image.getRow(j);
+
+        forEachRun(j,
+                   0,
+                   m_width,
+                   [row](int32_t x, int32_t length, uint16_t rgb)
+                   {
+                       std::fill_n(row + x, length, rgb);
+                   },
+                   [row](int32_t x, const uint16_t* pixels, int32_t length)
+                   {
+                       std::copy(pixels, pixels + length, row + x);
+                   });
+    }
+
+    return image;
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::Rle565:: encodeRow(
+    const uint16_t* row)
+{
+    int32_t literalStart{0};
+    int32_t i{0};
+
+    while (i < m_width)
+    {
+        int32_t run{1};
+
+        while (((i + run) < m_width) &&
+               (run < sc_maxRun) &&
+               (row[i + run] == row[i]))
+        {
+            ++run;
+        }
+
+        if (run >= sc_minFill)
+        {
+            addLiteral(row + literalStart, i - literalStart);
+
+            m_data.push_back(run);
+            m_data.push_back(row[i]);
+
+            literalStart = i + run;
+        }
+
+        i += run;
+    }
+
+    addLiteral(row + literalStart, m_width - literalStart);
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::Rle565:: addLiteral(
+    const uint16_t* pixels,
+    int32_t length)
+{
+    while (length > 0)
+    {
+        int32_t run = std::min(length, sc_maxRun);
+
+        m_data.push_back(sc_literal | run);
+        m_data.insert(m_data.end(), pixels, pixels + run);
+
+        pixels += run;
+        length -= run;
+    }
+}
+
+//-------------------------------------------------------------------------
+
+bool
+raspifb16::putImage(
+    Image565View image,
+    const Image565Point& p,
+    const Rle565& rle)
+{
+    int32_t x0 = std::max<int32_t>(p.x(), 0);
+    int32_t x1 = std::min<int32_t>(p.x() + rle.getWidth(),
+                                   image.getWidth());
+    int32_t y0 = std::max<int32_t>(p.y(), 0);
+    int32_t y1 = std::min<int32_t>(p.y() + rle.getHeight(),
+                                   image.getHeight());
+
+    if ((x0 >= x1) || (y0 >= y1))
+    {
+        return false;
+    }
+
+    for (int32_t j = y0 ; j < y1 ; ++j)
+    {
+        auto row = image.getRow(j);
+        int32_t dx = p.x();
+
+        rle.forEachRun(j - p.y(),
+                       x0 - dx,
+                       x1 - dx,
+                       [row, dx](int32_t x, int32_t length, uint16_t rgb)
+                       {
+                           std::fill_n(row + x + dx, length, rgb);
+                       },
+                       [row, dx](int32_t x,
+                                 const uint16_t* pixels,
+                                 int32_t length)
+                       {
+                           memcpy(row + x + dx,
+                                  pixels,
+                                  length * sizeof(uint16_t));
+                       });
+    }
+
+    return true;
+}
@@ -0,0 +1,174 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef RLE565_H
+#define RLE565_H
+
+//-------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "image565.h"
+#include "image565View.h"
+#include "point.h"
+
+//-------------------------------------------------------------------------
+
+namespace raspifb16
+{
+
+//-------------------------------------------------------------------------
+
+// A run length encoded image, for content that is drawn often but seldom
+// changes. Each row is a list of runs: a fill run is a length and one
+// colour, a literal run is a length and that many pixels. Drawing a run
+// is a fill or a copy straight into the destination, so the image is
+// never decoded into a buffer of its own.
+//
+// Each run starts with a word holding its length, with the top bit set
+// for a literal run.
+
+class Rle565
+{
+public:
+
+    explicit Rle565(const Image565& image);
+
+    // Rebuild an image from the runs returned by getData(), for example
+    // after reading them back from a file. Throws std::invalid_argument
+    // if the runs of each row do not add up to width pixels.
+
+    Rle565(int16_t width, int16_t height, std::vector<uint16_t> data);
+
+    int16_t getWidth() const { return m_width; }
+    int16_t getHeight() const { return m_height; }
+
+    // The size of the encoded pixels in bytes.
+
+    size_t
+    getEncodedSize() const
+    {
+        return m_data.size() * sizeof(uint16_t);
+    }
+
+    const std::vector<uint16_t>& getData() const { return m_data; }
+
+    Image565 decode() const;
+
+    // Call fill(x, length, rgb) and copy(x, pixels, length) for each run
+    // in row y, clipped to columns x0 (inclusive) to x1 (exclusive).
+
+    template<typename Fill, typename Copy>
+    void
+    forEachRun(
+        int16_t y,
+        int32_t x0,
+        int32_t x1,
+        Fill fill,
+        Copy copy) const;
+
+private:
+
+    static constexpr uint16_t sc_literal{0x8000};
+    static constexpr int32_t sc_maxRun{0x7FFF};
+
+    // Shorter runs of one colour are cheaper to store as part of a
+    // literal run.
+
+    static constexpr int32_t sc_minFill{3};
+
+    void encodeRow(const uint16_t* row);
+    void addLiteral(const uint16_t* pixels, int32_t length);
+
+    int16_t m_width;
+    int16_t m_height;
+    std::vector<uint16_t> m_data;
+    std::vector<size_t> m_rows;
+};
+
+//-------------------------------------------------------------------------
+
+template<typename Fill, typename Copy>
+void
+Rle565:: forEachRun(
+    int16_t y,
+    int32_t x0,
+    int32_t x1,
+    Fill fill,
+    Copy copy) const
+{
+    auto data = m_data.data() + m_rows[y];
+    auto end = m_data.data() + m_rows[y + 1];
+    int32_t x{0};
+
+    while ((data < end) && (x < x1))
+    {
+        bool literal = (*data & sc_literal) != 0;
+        int32_t length = *data & ~sc_literal;
+        ++data;
+
+        int32_t start = std::max(x, x0);
+        int32_t stop = std::min(x + length, x1);
+
+        if (start < stop)
+        {
+            if (literal)
+            {
+                copy(start, data + (start - x), stop - start);
+            }
+            else
+            {
+                fill(start, stop - start, *data);
+            }
+        }
+
+        data += (literal) ? length : 1;
+        x += length;
+    }
+}
+
+//-------------------------------------------------------------------------
+
+// Draw rle onto image with its top left corner at p.
+
+bool
+putImage(
+    Image565View image,
+    const Image565Point& p,
+    const Rle565& rle);
+
+//-------------------------------------------------------------------------
+
+} // namespace raspifb16
+
+//-------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,177 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#include <algorithm>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "blend565.h"
+#include "scale565.h"
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::scaleRowNearest(
+    uint16_t* dst,
+    int32_t length,
+    const uint16_t* src,
+    int32_t srcLength,
+    int32_t x,
+    int32_t step)
+{
+    for (int32_t i = 0 ; i < length ; ++i)
+    {
+        int32_t sx = std::min(std::max(x >> 16, 0), srcLength - 1);
+
+        dst[i] = src[sx];
+        x += step;
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::scaleRowBilinear(
+    uint16_t* dst,
+    int32_t length,
+    const uint16_t* src,
+    int32_t srcLength,
+    int32_t x,
+    int32_t step)
+{
+    for (int32_t i = 0 ; i < length ; ++i)
+    {
+        if (x <= 0)
+        {
+            dst[i] = src[0];
+        }
+        else if ((x >> 16) >= (srcLength - 1))
+        {
+            dst[i] = src[srcLength - 1];
+        }
+        else
+        {
+            int32_t sx = x >> 16;
+            dst[i] = lerp565(src[sx], src[sx + 1], (x >> 11) & 0x1F);
+        }
+
+        x += step;
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+raspifb16::lerpRow(
+    uint16_t* dst,
+    const uint16_t* a,
+    const uint16_t* b,
+    int32_t length,
+    uint8_t weight)
+{
+    int32_t i = 0;
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+    const int16x8_t w = vdupq_n_s16(weight);
+    const uint16x8_t mask6 = vdupq_n_u16(0x3F);
+    const uint16x8_t mask5 = vdupq_n_u16(0x1F);
+
+    auto channel = [&w](int16x8_t ca, int16x8_t cb) -> int16x8_t
+    {
+        int16x8_t delta = vmulq_s16(vsubq_s16(cb, ca), w);
+        return vaddq_s16(ca, vshrq_n_s16(delta, 5));
+    };
+
+    for ( ; (i + 8) <= length ; i += 8)
+    {
+        uint16x8_t pa = vld1q_u16(a + i);
+        uint16x8_t pb = vld1q_u16(b + i);
+
+        int16x8_t ra = vreinterpretq_s16_u16(vshrq_n_u16(pa, 11));
+        int16x8_t rb = vreinterpretq_s16_u16(vshrq_n_u16(pb, 11));
+        int16x8_t ga = vreinterpretq_s16_u16(
+            vandq_u16(vshrq_n_u16(pa, 5), mask6));
+        int16x8_t gb = vreinterpretq_s16_u16(
+            vandq_u16(vshrq_n_u16(pb, 5), mask6));
+        int16x8_t ba = vreinterpretq_s16_u16(vandq_u16(pa, mask5));
+        int16x8_t bb = vreinterpretq_s16_u16(vandq_u16(pb, mask5));
+
+        uint16x8_t red = vreinterpretq_u16_s16(channel(ra, rb));
+        uint16x8_t green = vreinterpretq_u16_s16(channel(ga, gb));
+        uint16x8_t blue = vreinterpretq_u16_s16(channel(ba, bb));
+
+        uint16x8_t rgb = vorrq_u16(vorrq_u16(vshlq_n_u16(red, 11),
+                                             vshlq_n_u16(green, 5)),
+                                   blue);
+
+        vst1q_u16(dst + i, rgb);
+    }
+
+#elif defined(__SSE2__)
+
+    const __m128i w = _mm_set1_epi16(weight);
+    const __m128i mask6 = _mm_set1_epi16(0x3F);
+    const __m128i mask5 = _mm_set1_epi16(0x1F);
+
+    auto channel = [&w](__m128i ca, __m128i cb) -> __m128i
+    {
+        __m128i delta = _mm_mullo_epi16(_mm_sub_epi16(cb, ca), w);
+        return _mm_add_epi16(ca, _mm_srai_epi16(delta, 5));
+    };
+
+    for ( ; (i + 8) <= length ; i += 8)
+    {
+        __m128i pa = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i pb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+
+        __m128i red = channel(_mm_srli_epi16(pa, 11),
+                              _mm_srli_epi16(pb, 11));
+        __m128i green = channel(_mm_and_si128(_mm_srli_epi16(pa, 5), mask6),
+                                _mm_and_si128(_mm_srli_epi16(pb, 5), mask6));
+        __m128i blue = channel(_mm_and_si128(pa, mask5),
+                               _mm_and_si128(pb, mask5));
+
+        __m128i rgb = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(red, 11),
+                                                _mm_slli_epi16(green, 5)),
+                                   blue);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), rgb);
+    }
+
+#endif
+
+    for ( ; i < length ; ++i)
+    {
+        dst[i] = lerp565(a[i], b[i], weight);
+    }
+}
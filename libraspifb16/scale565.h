@@ -0,0 +1,85 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef SCALE565_H
+#define SCALE565_H
+
+//-------------------------------------------------------------------------
+
+#include <cstdint>
+
+//-------------------------------------------------------------------------
+
+namespace raspifb16
+{
+
+//-------------------------------------------------------------------------
+
+enum class ScaleFilter { NEAREST, BILINEAR };
+
+//-------------------------------------------------------------------------
+
+// Row kernels used to scale RGB565 images. Source positions are 16.16
+// fixed point: x is the position of the first destination pixel and step
+// is the distance between destination pixels, both in source pixels.
+
+void
+scaleRowNearest(
+    uint16_t* dst,
+    int32_t length,
+    const uint16_t* src,
+    int32_t srcLength,
+    int32_t x,
+    int32_t step);
+
+void
+scaleRowBilinear(
+    uint16_t* dst,
+    int32_t length,
+    const uint16_t* src,
+    int32_t srcLength,
+    int32_t x,
+    int32_t step);
+
+// dst = a + (b - a) * weight / 32, for weight in the range 0 to 32.
+
+void
+lerpRow(
+    uint16_t* dst,
+    const uint16_t* a,
+    const uint16_t* b,
+    int32_t length,
+    uint8_t weight);
+
+//-------------------------------------------------------------------------
+
+} // namespace raspifb16
+
+//-------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,148 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#include <algorithm>
+#include <cstring>
+
+#include "image565View.h"
+#include "sprite565.h"
+
+//-------------------------------------------------------------------------
+
+raspifb16::Sprite565:: Sprite565(
+    const Image565& image,
+    const RGB565& key)
+:
+    Sprite565(image, key.get565())
+{
+}
+
+//-------------------------------------------------------------------------
+
+raspifb16::Sprite565:: Sprite565(
+    const Image565& image,
+    uint16_t key)
+:
+    m_image(image),
+    m_key{key},
+    m_spans(),
+    m_rowSpans()
+{
+    m_rowSpans.reserve(getHeight() + 1);
+
+    for (int16_t j = 0 ; j < getHeight() ; ++j)
+    {
+        m_rowSpans.push_back(m_spans.size());
+
+        auto row = m_image.getRow(j);
+        int16_t i = 0;
+
+        while (i < getWidth())
+        {
+            while ((i < getWidth()) && (row[i] == m_key))
+            {
+                ++i;
+            }
+
+            int16_t start = i;
+
+            while ((i < getWidth()) && (row[i] != m_key))
+            {
+                ++i;
+            }
+
+            if (i > start)
+            {
+                int16_t length = i - start;
+                m_spans.push_back(Span{start, length});
+            }
+        }
+    }
+
+    m_rowSpans.push_back(m_spans.size());
+}
+
+//-------------------------------------------------------------------------
+
+raspifb16::Sprite565::Spans
+raspifb16::Sprite565:: getSpans(
+    int16_t y) const
+{
+    if ((y < 0) || (y >= getHeight()))
+    {
+        return Spans{nullptr, nullptr};
+    }
+
+    return Spans{m_spans.data() + m_rowSpans[y],
+                 m_spans.data() + m_rowSpans[y + 1]};
+}
+
+//-------------------------------------------------------------------------
+
+bool
+raspifb16::putSprite(
+    Image565View image,
+    const Image565Point& p,
+    const Sprite565& sprite)
+{
+    int32_t x0 = std::max<int32_t>(p.x(), 0);
+    int32_t x1 = std::min<int32_t>(p.x() + sprite.getWidth(),
+                                   image.getWidth());
+    int32_t y0 = std::max<int32_t>(p.y(), 0);
+    int32_t y1 = std::min<int32_t>(p.y() + sprite.getHeight(),
+                                   image.getHeight());
+
+    if ((x0 >= x1) || (y0 >= y1))
+    {
+        return false;
+    }
+
+    for (int32_t j = y0 ; j < y1 ; ++j)
+    {
+        int16_t sy = j - p.y();
+        auto src = sprite.getRow(sy);
+        auto dst = image.getRow(j);
+        auto spans = sprite.getSpans(sy);
+
+        for (auto span = spans.first ; span != spans.second ; ++span)
+        {
+            int32_t start = std::max<int32_t>(span->m_x + p.x(), x0);
+            int32_t end = std::min<int32_t>(span->m_x + span->m_length + p.x(),
+                                            x1);
+
+            if (start < end)
+            {
+                memcpy(dst + start,
+                       src + (start - p.x()),
+                       (end - start) * sizeof(uint16_t));
+            }
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,106 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef SPRITE565_H
+#define SPRITE565_H
+
+//-------------------------------------------------------------------------
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "image565.h"
+#include "image565View.h"
+#include "point.h"
+#include "rgb565.h"
+
+//-------------------------------------------------------------------------
+
+namespace raspifb16
+{
+
+//-------------------------------------------------------------------------
+
+// An image with a key colour that is treated as transparent. The opaque
+// runs in each row are found once, at construction, so drawing a sprite
+// is a copy per run with no per pixel comparison.
+
+class Sprite565
+{
+public:
+
+    struct Span
+    {
+        int16_t m_x;
+        int16_t m_length;
+    };
+
+    using Spans = std::pair<const Span*, const Span*>;
+
+    Sprite565(const Image565& image, const RGB565& key);
+    Sprite565(const Image565& image, uint16_t key);
+
+    int16_t getWidth() const { return m_image.getWidth(); }
+    int16_t getHeight() const { return m_image.getHeight(); }
+
+    const Image565& getImage() const { return m_image; }
+    uint16_t getKey() const { return m_key; }
+
+    const uint16_t* getRow(int16_t y) const { return m_image.getRow(y); }
+
+    // The opaque runs in row y, in order from left to right.
+
+    Spans getSpans(int16_t y) const;
+
+private:
+
+    Image565 m_image;
+    uint16_t m_key;
+    std::vector<Span> m_spans;
+    std::vector<size_t> m_rowSpans;
+};
+
+//-------------------------------------------------------------------------
+
+// Draw the opaque pixels of sprite onto image with its top left corner
+// at p.
+
+bool
+putSprite(
+    Image565View image,
+    const Image565Point& p,
+    const Sprite565& sprite);
+
+//-------------------------------------------------------------------------
+
+} // namespace raspifb16
+
+//-------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,147 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+//-------------------------------------------------------------------------
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+//-------------------------------------------------------------------------
+
+namespace raspifb16
+{
+
+//-------------------------------------------------------------------------
+
+// Lock-free bounded queue for exactly one producer thread and one
+// consumer thread. Elements live in preallocated slots and are filled and
+// read in place, so a slot's storage is reused rather than reallocated.
+//
+// Producer: slot = back(); if (slot) { fill *slot; push(); }
+// Consumer: slot = front(); if (slot) { use *slot; pop(); }
+
+template<typename T>
+class SpscQueue
+{
+public:
+
+    explicit SpscQueue(size_t capacity)
+    :
+        m_slots(capacity + 1),
+        m_head{0},
+        m_tail{0}
+    {
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator= (const SpscQueue&) = delete;
+
+    size_t capacity() const { return m_slots.size() - 1; }
+
+    // Producer side.
+
+    T*
+    back()
+    {
+        auto tail = m_tail.load(std::memory_order_relaxed);
+
+        if (next(tail) == m_head.load(std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+
+        return &m_slots[tail];
+    }
+
+    void
+    push()
+    {
+        auto tail = m_tail.load(std::memory_order_relaxed);
+        m_tail.store(next(tail), std::memory_order_release);
+    }
+
+    // Consumer side. at(n) is the nth element after front().
+
+    T*
+    front()
+    {
+        return at(0);
+    }
+
+    T*
+    at(size_t n)
+    {
+        if (n >= size())
+        {
+            return nullptr;
+        }
+
+        return &m_slots[(m_head.load(std::memory_order_relaxed) + n)
+                        % m_slots.size()];
+    }
+
+    void
+    pop()
+    {
+        auto head = m_head.load(std::memory_order_relaxed);
+        m_head.store(next(head), std::memory_order_release);
+    }
+
+    // Either side, the result may be out of date as soon as it returns.
+
+    size_t
+    size() const
+    {
+        auto head = m_head.load(std::memory_order_acquire);
+        auto tail = m_tail.load(std::memory_order_acquire);
+
+        return (tail + m_slots.size() - head) % m_slots.size();
+    }
+
+    bool empty() const { return size() == 0; }
+
+private:
+
+    size_t next(size_t index) const { return (index + 1) % m_slots.size(); }
+
+    std::vector<T> m_slots;
+    std::atomic<size_t> m_head;
+    std::atomic<size_t> m_tail;
+};
+
+//-------------------------------------------------------------------------
+
+} // namespace raspifb16
+
+//-------------------------------------------------------------------------
+
+#endif
@@ -29,11 +29,46 @@
 
 //-------------------------------------------------------------------------
 
+namespace
+{
+raspifb16::CallCounter showCounter;
+}
+
+//-------------------------------------------------------------------------
+
 void
 Panel::
 show(
     const raspifb16::FrameBuffer565& fb) const
 {
+    raspifb16::CallTimer timer{showCounter};
+
     fb.putImage(raspifb16::FB565Point(0, m_yPosition), m_image);
+
+    timer.count(m_image.getWidth() * m_image.getHeight(),
+                fb.getBytesWritten());
 }
 
+
+//-------------------------------------------------------------------------
+
+void
+Panel::
+show(
+    raspifb16::Presenter& presenter) const
+{
+    raspifb16::CallTimer timer{showCounter};
+
+    presenter.submit(raspifb16::FB565Point(0, m_yPosition), m_image);
+
+    timer.count(m_image.getWidth() * m_image.getHeight(), 0);
+}
+
+//-------------------------------------------------------------------------
+
+raspifb16::CallStatistics
+Panel::
+getShowStatistics()
+{
+    return showCounter.snapshot();
+}
@@ -32,8 +32,10 @@
 
 #include <cstdint>
 
+#include "callStatistics.h"
 #include "framebuffer565.h"
 #include "image565.h"
+#include "presenter.h"
 
 //-------------------------------------------------------------------------
 
@@ -47,7 +49,7 @@ public:
         int16_t yPosition)
     :
         m_yPosition{yPosition},
-        m_image{width, height}
+        m_image{width, height, raspifb16::Image565::Layout::ALIGNED}
     { }
 
 
@@ -59,8 +61,13 @@ public:
     const raspifb16::Image565& getImage() const { return m_image; }
 
     void show(const raspifb16::FrameBuffer565& fb) const;
+    void show(raspifb16::Presenter& presenter) const;
     virtual void update(time_t now) = 0;
 
+    // Totals for show() across every panel.
+
+    static raspifb16::CallStatistics getShowStatistics();
+
 private:
 
     int16_t m_yPosition;
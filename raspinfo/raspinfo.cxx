@@ -32,6 +32,8 @@
 #include <exception>
 #include <iostream>
 #include <memory>
+#include <string>
+#include <system_error>
 #include <thread>
 #include <vector>
 
@@ -52,8 +54,11 @@
 #include <bcm_host.h>
 #pragma GCC diagnostic pop
 
+#include "callStatistics.h"
 #include "cpuTrace.h"
 #include "dynamicInfo.h"
+#include "fileDescriptor.h"
+#include "frameCapture.h"
 #include "framebuffer565.h"
 #include "memoryTrace.h"
 
@@ -134,6 +139,48 @@ perrorLog(
 
 //-------------------------------------------------------------------------
 
+void
+statisticsLog(
+    bool isDaemon,
+    const std::string& name,
+    const std::string& call,
+    const raspifb16::CallStatistics& statistics)
+{
+    if (statistics.m_calls == 0)
+    {
+        return;
+    }
+
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+
+    auto toMicroseconds = [](std::chrono::nanoseconds ns)
+    {
+        return std::to_string(duration_cast<microseconds>(ns).count());
+    };
+
+    std::string message{call};
+
+    message += " ";
+    message += std::to_string(statistics.m_calls);
+    message += " calls, ";
+    message += std::to_string(statistics.m_pixels);
+    message += " pixels, ";
+    message += std::to_string(statistics.m_bytes);
+    message += " bytes, time (us) total ";
+    message += toMicroseconds(statistics.m_totalTime);
+    message += " average ";
+    message += toMicroseconds(statistics.m_totalTime / statistics.m_calls);
+    message += " 50% under ";
+    message += toMicroseconds(statistics.percentile(0.5));
+    message += " 99% under ";
+    message += toMicroseconds(statistics.percentile(0.99));
+
+    messageLog(isDaemon, name, LOG_INFO, message);
+}
+
+//-------------------------------------------------------------------------
+
 
 void
 printUsage(
@@ -143,12 +190,21 @@ printUsage(
     os << "\n";
     os << "Usage: " << name << " <options>\n";
     os << "\n";
+    os << "    --async,-a - write to the framebuffer on a separate thread\n";
+    os << "    --capture,-c <file> - stream raw RGB565 frames to a file";
+    os << " or pipe\n";
     os << "    --daemon,-D - start in the background as a daemon\n";
     os << "    --device,-d - framebuffer device to use";
-    os << " (default is " << defaultDevice << ")\n";
+    os << " (default is " << defaultDevice << "), repeat to show the";
+    os << " same display on more than one device\n";
+    os << "    --double-buffer,-b - draw off screen and flip once per update\n";
+    os << "    --flush,-f - push each update to a deferred I/O display";
+    os << " in one go\n";
     os << "    --help,-h - print usage and exit\n";
     os << "    --pidfile,-p <pidfile> - create and lock PID file";
     os << " (if being run as a daemon)\n";
+    os << "    --shadow,-s - only write pixels that have changed\n";
+    os << "    --vsync,-v - present updates at the vertical blank\n";
     os << "\n";
 }
 
@@ -185,19 +241,31 @@ main(
     int argc,
     char *argv[])
 {
-    const char* device = defaultDevice;
+    std::vector<std::string> devices;
     char* program = basename(argv[0]);
     char* pidfile = nullptr;
     bool isDaemon =  false;
+    auto buffering = raspifb16::FrameBuffer565::Buffering::SINGLE;
+    bool isShadowed = false;
+    bool isVsynced = false;
+    bool isAsync = false;
+    bool isFlushed = false;
+    char* captureFile = nullptr;
 
     //---------------------------------------------------------------------
 
-    static const char* sopts = "d:hp:D";
+    static const char* sopts = "abc:d:fhp:svD";
     static struct option lopts[] = 
     {
+        { "async", no_argument, nullptr, 'a' },
+        { "capture", required_argument, nullptr, 'c' },
         { "device", required_argument, nullptr, 'd' },
+        { "double-buffer", no_argument, nullptr, 'b' },
+        { "flush", no_argument, nullptr, 'f' },
         { "help", no_argument, nullptr, 'h' },
         { "pidfile", required_argument, nullptr, 'p' },
+        { "shadow", no_argument, nullptr, 's' },
+        { "vsync", no_argument, nullptr, 'v' },
         { "daemon", no_argument, nullptr, 'D' },
         { nullptr, no_argument, nullptr, 0 }
     };
@@ -208,9 +276,33 @@ main(
     {
         switch (opt)
         {
+        case 'a':
+
+            isAsync = true;
+
+            break;
+
+        case 'b':
+
+            buffering = raspifb16::FrameBuffer565::Buffering::DOUBLE;
+
+            break;
+
+        case 'c':
+
+            captureFile = optarg;
+
+            break;
+
         case 'd':
 
-            device = optarg;
+            devices.push_back(optarg);
+
+            break;
+
+        case 'f':
+
+            isFlushed = true;
 
             break;
 
@@ -227,6 +319,18 @@ main(
 
             break;
 
+        case 's':
+
+            isShadowed = true;
+
+            break;
+
+        case 'v':
+
+            isVsynced = true;
+
+            break;
+
         case 'D':
 
             isDaemon = true;
@@ -242,6 +346,27 @@ main(
         }
     }
 
+    if (devices.empty())
+    {
+        devices.push_back(defaultDevice);
+    }
+
+    // Each extra device is a target of the presenter.
+
+    if (devices.size() > 1)
+    {
+        isAsync = true;
+    }
+
+    if (isAsync && (captureFile != nullptr))
+    {
+        std::cerr
+            << program
+            << ": --capture cannot be used with --async or more than one"
+            << " --device\n";
+        ::exit(EXIT_FAILURE);
+    }
+
     //---------------------------------------------------------------------
 
     struct pidfh* pfh = nullptr;
@@ -315,9 +440,33 @@ main(
 
     try
     {
-        raspifb16::FrameBuffer565 fb(device);
+        using FrameBuffers =
+            std::vector<std::unique_ptr<raspifb16::FrameBuffer565>>;
+
+        FrameBuffers framebuffers;
 
-        fb.clear(raspifb16::RGB565{0, 0, 0});
+        for (const auto& device : devices)
+        {
+            framebuffers.push_back(
+                std::make_unique<raspifb16::FrameBuffer565>(device,
+                                                            buffering));
+
+            auto& target = *framebuffers.back();
+            target.setShadowEnabled(isShadowed);
+            target.setVsyncEnabled(isVsynced);
+
+            if (isFlushed)
+            {
+                using FlushMode = raspifb16::FrameBuffer565::FlushMode;
+                target.setFlushMode(FlushMode::ON_PRESENT);
+            }
+
+            target.clear(raspifb16::RGB565{0, 0, 0});
+        }
+
+        // The panels are laid out to fit the first device.
+
+        auto& fb = *framebuffers.front();
 
         //-----------------------------------------------------------------
 
@@ -366,9 +515,56 @@ main(
 
         //-----------------------------------------------------------------
 
+        std::unique_ptr<raspifb16::Presenter> presenter;
+
+        if (isAsync)
+        {
+            presenter = std::make_unique<raspifb16::Presenter>(fb);
+
+            for (size_t i = 1 ; i < framebuffers.size() ; ++i)
+            {
+                presenter->addTarget(*framebuffers[i]);
+            }
+        }
+
+        //-----------------------------------------------------------------
+
+        raspifb16::FileDescriptor captureFd{-1};
+        std::unique_ptr<raspifb16::FrameCapture> capture;
+
+        if (captureFile != nullptr)
+        {
+            // A reader going away should stop the capture, not raspinfo.
+
+            std::signal(SIGPIPE, SIG_IGN);
+
+            captureFd = raspifb16::FileDescriptor{
+                ::open(captureFile, O_WRONLY | O_CREAT | O_TRUNC, 0644)};
+
+            if (captureFd.fd() == -1)
+            {
+                throw std::system_error(errno,
+                                        std::system_category(),
+                                        "cannot open capture file");
+            }
+
+            capture = std::make_unique<raspifb16::FrameCapture>(
+                fb,
+                captureFd.fd(),
+                true);
+        }
+
+        //-----------------------------------------------------------------
+
+        // Time spent sampling, to set against the time spent drawing.
+
+        raspifb16::CallCounter updateCounter;
+
         constexpr auto oneSecond(std::chrono::seconds(1));
 
-        std::this_thread::sleep_for(oneSecond);
+        auto nextUpdate = std::chrono::steady_clock::now() + oneSecond;
+
+        std::this_thread::sleep_until(nextUpdate);
 
         while (run)
         {
@@ -377,18 +573,116 @@ main(
 
             for (auto& panel : panels)
             {
-                panel->update(now_t);
+                {
+                    raspifb16::CallTimer timer{updateCounter};
+                    panel->update(now_t);
+                }
 
-                if (display)
+                if (display && presenter)
+                {
+                    panel->show(*presenter);
+                }
+                else if (display)
                 {
                     panel->show(fb);
                 }
             }
 
-            std::this_thread::sleep_for(oneSecond);
+            if (display && presenter)
+            {
+                presenter->present();
+            }
+            else if (display)
+            {
+                fb.present();
+
+                if (capture)
+                {
+                    capture->capture();
+                }
+            }
+
+            nextUpdate += oneSecond;
+            std::this_thread::sleep_until(nextUpdate);
         }
 
-        fb.clear();
+        presenter.reset();
+        capture.reset();
+
+        statisticsLog(isDaemon,
+                      program,
+                      "update",
+                      updateCounter.snapshot());
+        statisticsLog(isDaemon,
+                      program,
+                      "show",
+                      Panel::getShowStatistics());
+
+        //-----------------------------------------------------------------
+
+        for (size_t i = 0 ; i < framebuffers.size() ; ++i)
+        {
+            auto& target = *framebuffers[i];
+
+            target.clear();
+            target.present();
+
+            std::string prefix;
+
+            if (framebuffers.size() > 1)
+            {
+                prefix = devices[i] + ": ";
+            }
+
+            auto drawStatistics = target.getDrawStatistics();
+
+            statisticsLog(isDaemon,
+                          program,
+                          prefix + "putImage",
+                          drawStatistics.m_putImage);
+            statisticsLog(isDaemon,
+                          program,
+                          prefix + "clear",
+                          drawStatistics.m_clear);
+            statisticsLog(isDaemon,
+                          program,
+                          prefix + "flush",
+                          drawStatistics.m_flush);
+
+            const auto& statistics = target.getPresentStatistics();
+
+            if (statistics.m_frames == 0)
+            {
+                continue;
+            }
+
+            using std::chrono::duration_cast;
+            using std::chrono::microseconds;
+
+            auto average = statistics.m_totalLatency / statistics.m_frames;
+            auto copy = statistics.m_totalCopyTime / statistics.m_frames;
+
+            std::string message{prefix};
+
+            message += "presented ";
+            message += std::to_string(statistics.m_frames);
+            message += " frames, missed ";
+            message += std::to_string(statistics.m_missedVsyncs);
+            message += " vsyncs, latency (us) min ";
+            message += std::to_string(
+                duration_cast<microseconds>(statistics.m_minLatency).count());
+            message += " average ";
+            message += std::to_string(
+                duration_cast<microseconds>(average).count());
+            message += " max ";
+            message += std::to_string(
+                duration_cast<microseconds>(statistics.m_maxLatency).count());
+            message += ", copy average ";
+            message += std::to_string(
+                duration_cast<microseconds>(copy).count());
+
+            messageLog(isDaemon, program, LOG_INFO, message);
+        }
     }
     catch (std::exception& error)
     {
@@ -64,6 +64,8 @@ Trace(
     m_gridHeight{gridHeight},
     m_columns{0},
     m_autoScale{traceScale == 0},
+    m_scrolled{false},
+    m_rescaled{false},
     m_traceData(),
     m_time(width)
 {
@@ -157,7 +159,9 @@ addData(
 {
     int16_t index{0};
 
-    if (m_columns < getImage().getWidth())
+    m_scrolled = (m_columns == getImage().getWidth());
+
+    if (!m_scrolled)
     {
         index = m_columns++;
     }
@@ -187,8 +191,11 @@ addData(
 
     //-----------------------------------------------------------------
 
+    m_rescaled = false;
+
     if (m_autoScale)
     {
+        auto previousScale = m_traceScale;
         m_traceScale = 0;
 
         for (auto& trace : m_traceData)
@@ -203,6 +210,8 @@ addData(
         {
             m_traceScale = 1;
         }
+
+        m_rescaled = (m_traceScale != previousScale);
     }
 
     //-----------------------------------------------------------------
@@ -91,6 +91,13 @@ protected:
 
     bool m_autoScale;
 
+    // Set by addData() for draw(). When the data has scrolled, every
+    // column has moved one to the left. When the scale has changed,
+    // every column needs to be drawn again.
+
+    bool m_scrolled;
+    bool m_rescaled;
+
     std::vector<TraceData> m_traceData;
     std::vector<int8_t> m_time;
 
@@ -31,7 +31,9 @@
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <vector>
 
+#include "image565.h"
 #include "traceStack.h"
 #include "rgb565.h"
 
@@ -68,47 +70,80 @@ void
 TraceStack::
 draw()
 {
-    for (int16_t i = 0 ; i < m_columns ; ++i)
+    // The traces are stacked from the bottom, but drawn from the top of
+    // each column down, so the cursor never leaves the image.
+
+    std::vector<int16_t> heights(m_traceData.size());
+
+    // Unless the scale has changed, only the newest column is drawn. The
+    // rest are moved into place in the image.
+
+    int16_t first = 0;
+
+    if (!m_rescaled && (m_columns > 0))
+    {
+        if (m_scrolled)
+        {
+            getImage().scroll(
+                raspifb16::Image565Rectangle(0, 0, m_columns, m_traceHeight),
+                -1,
+                0,
+                sc_background.get565());
+        }
+
+        first = m_columns - 1;
+    }
+
+    for (int16_t i = first ; i < m_columns ; ++i)
     {
-        int16_t j = m_traceHeight - 1;
+        int16_t total = 0;
 
-        for (auto& trace : m_traceData)
+        for (size_t t = 0 ; t < m_traceData.size() ; ++t)
         {
-            int16_t value = (trace.m_values[i] * m_traceHeight)
+            int16_t value = (m_traceData[t].m_values[i] * m_traceHeight)
                           / m_traceScale;
 
-            for (int16_t v = 0 ; v < value ; ++v)
+            heights[t] = std::max<int16_t>(
+                std::min<int16_t>(value, m_traceHeight - total), 0);
+            total += heights[t];
+        }
+
+        raspifb16::Image565Cursor cursor{getImage(),
+                                         raspifb16::Image565Point{i, 0}};
+
+        auto drawRun = [&](int16_t top,
+                           int16_t bottom,
+                           const raspifb16::RGB565& colour,
+                           const raspifb16::RGB565& gridColour)
+        {
+            for (int16_t j = top ; j < bottom ; ++j)
             {
                 if (((j % m_gridHeight) == 0) || (m_time[i] == 0))
                 {
-                    getImage().setPixelRGB(
-                        raspifb16::Image565Point{i, j--},
-                        trace.m_gridColour);
+                    cursor.set(gridColour.get565());
                 }
                 else
                 {
-                    getImage().setPixelRGB(
-                        raspifb16::Image565Point{i, j--},
-                        trace.m_traceColour);
+                    cursor.set(colour.get565());
                 }
+
+                cursor.down();
             }
-        }
+        };
+
+        int16_t j = m_traceHeight - total;
+
+        drawRun(0, j, sc_background, sc_gridColour);
 
-        for ( ; j >= 0 ; --j)
+        for (size_t t = m_traceData.size() ; t > 0 ; --t)
         {
-            if (((j % m_gridHeight) == 0) || (m_time[i] == 0))
-            {
-                getImage().setPixelRGB(
-                    raspifb16::Image565Point{i, j},
-                    sc_gridColour);
-            }
-            else
-            {
-                getImage().setPixelRGB(
-                    raspifb16::Image565Point{i, j},
-                    sc_background);
-            }
+            const auto& trace = m_traceData[t - 1];
+
+            drawRun(j,
+                    j + heights[t - 1],
+                    trace.m_traceColour,
+                    trace.m_gridColour);
+            j += heights[t - 1];
         }
     }
 }
- 
@@ -0,0 +1,816 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include <getopt.h>
+#include <unistd.h>
+
+#ifdef RASPIFB16_ZLIB
+#include <zlib.h>
+#endif
+
+#include "blit565.h"
+#include "compositor.h"
+#include "convert565.h"
+#include "framebuffer565.h"
+#include "image565.h"
+#include "image565Alpha.h"
+#include "image565Font.h"
+#include "image565Graphics.h"
+#include "imageDecoder.h"
+#include "mappedImage565.h"
+#include "point.h"
+#include "rle565.h"
+#include "sprite565.h"
+
+//-------------------------------------------------------------------------
+
+using namespace raspifb16;
+
+//-------------------------------------------------------------------------
+
+void
+printUsage(
+    std::ostream& os,
+    const std::string& name)
+{
+    os << "\n";
+    os << "Usage: " << name << " <options>\n";
+    os << "\n";
+    os << "    --device,-d - framebuffer device to use";
+    os << " (default is mem:800x480)\n";
+    os << "    --help,-h - print usage and exit\n";
+    os << "    --iterations,-i <count> - number of times to run each test";
+    os << " (default is 100)\n";
+    os << "\n";
+}
+
+//-------------------------------------------------------------------------
+
+void
+benchmark(
+    const std::string& name,
+    int iterations,
+    int64_t pixels,
+    const std::function<void()>& function)
+{
+    using namespace std::chrono;
+
+    function();
+
+    auto start = steady_clock::now();
+
+    for (int i = 0 ; i < iterations ; ++i)
+    {
+        function();
+    }
+
+    auto elapsed = duration_cast<microseconds>(steady_clock::now() - start);
+    double us = std::max(static_cast<double>(elapsed.count()), 1.0);
+
+    std::cout
+        << std::left << std::setw(40) << name << std::right
+        << std::fixed << std::setprecision(1)
+        << std::setw(10) << (us / iterations) << " us"
+        << std::setw(10) << ((pixels * iterations) / us)
+        << " Mpixel/s\n";
+}
+
+//-------------------------------------------------------------------------
+
+// Read a string in place, so each decode starts without copying the
+// encoded image.
+
+class StringBuffer
+:
+    public std::streambuf
+{
+public:
+
+    explicit StringBuffer(const std::string& data)
+    {
+        auto begin = const_cast<char*>(data.data());
+        setg(begin, begin, begin + data.size());
+    }
+};
+
+//-------------------------------------------------------------------------
+
+void
+appendBigEndian32(
+    std::string& data,
+    uint32_t value)
+{
+    data += static_cast<char>(value >> 24);
+    data += static_cast<char>(value >> 16);
+    data += static_cast<char>(value >> 8);
+    data += static_cast<char>(value);
+}
+
+//-------------------------------------------------------------------------
+
+std::string
+encodePpm(
+    int width,
+    int height,
+    const std::vector<uint8_t>& rgb)
+{
+    auto data = "P6\n" + std::to_string(width) + " " +
+                std::to_string(height) + "\n255\n";
+
+    return data + std::string(rgb.begin(), rgb.end());
+}
+
+//-------------------------------------------------------------------------
+
+std::string
+encodeQoi(
+    int width,
+    int height,
+    const std::vector<uint8_t>& rgb)
+{
+    std::string data{"qoif"};
+    appendBigEndian32(data, width);
+    appendBigEndian32(data, height);
+    data += std::string{"\x03\x00", 2};
+
+    uint8_t index[64][3]{};
+    uint8_t previous[3]{0, 0, 0};
+    int run{0};
+
+    for (size_t i = 0 ; i < rgb.size() ; i += 3)
+    {
+        const auto p = rgb.data() + i;
+
+        if (std::equal(p, p + 3, previous))
+        {
+            if ((++run == 62) || (i + 3 == rgb.size()))
+            {
+                data += static_cast<char>(0xC0 | (run - 1));
+                run = 0;
+            }
+
+            continue;
+        }
+
+        if (run > 0)
+        {
+            data += static_cast<char>(0xC0 | (run - 1));
+            run = 0;
+        }
+
+        const int hash = ((p[0] * 3) + (p[1] * 5) + (p[2] * 7) + 255 * 11)
+                       & 63;
+
+        if (std::equal(p, p + 3, index[hash]))
+        {
+            data += static_cast<char>(hash);
+        }
+        else
+        {
+            std::copy(p, p + 3, index[hash]);
+
+            const int8_t dr = p[0] - previous[0];
+            const int8_t dg = p[1] - previous[1];
+            const int8_t db = p[2] - previous[2];
+
+            if ((dr >= -2) && (dr <= 1) &&
+                (dg >= -2) && (dg <= 1) &&
+                (db >= -2) && (db <= 1))
+            {
+                data += static_cast<char>(0x40 |
+                                          ((dr + 2) << 4) |
+                                          ((dg + 2) << 2) |
+                                          (db + 2));
+            }
+            else if ((dg >= -32) && (dg <= 31) &&
+                     (dr - dg >= -8) && (dr - dg <= 7) &&
+                     (db - dg >= -8) && (db - dg <= 7))
+            {
+                data += static_cast<char>(0x80 | (dg + 32));
+                data += static_cast<char>(((dr - dg + 8) << 4) |
+                                          (db - dg + 8));
+            }
+            else
+            {
+                data += '\xFE';
+                data.append(reinterpret_cast<const char*>(p), 3);
+            }
+        }
+
+        std::copy(p, p + 3, previous);
+    }
+
+    return data + std::string{"\0\0\0\0\0\0\0\x01", 8};
+}
+
+//-------------------------------------------------------------------------
+
+#ifdef RASPIFB16_ZLIB
+
+void
+appendPngChunk(
+    std::string& data,
+    const char* type,
+    const std::string& chunk)
+{
+    std::string body = type + chunk;
+
+    appendBigEndian32(data, chunk.size());
+    data += body;
+    appendBigEndian32(data,
+                      crc32(0,
+                            reinterpret_cast<const Bytef*>(body.data()),
+                            body.size()));
+}
+
+//-------------------------------------------------------------------------
+
+std::string
+encodePng(
+    int width,
+    int height,
+    const std::vector<uint8_t>& rgb)
+{
+    // Every row uses the Sub filter, which suits smooth images.
+
+    std::string rows;
+    const size_t rowBytes = width * 3;
+
+    for (size_t y = 0 ; y < static_cast<size_t>(height) ; ++y)
+    {
+        const auto row = rgb.data() + (y * rowBytes);
+        rows += '\x01';
+
+        for (size_t i = 0 ; i < rowBytes ; ++i)
+        {
+            rows += static_cast<char>(row[i] - ((i < 3) ? 0 : row[i - 3]));
+        }
+    }
+
+    std::vector<uint8_t> compressed(compressBound(rows.size()));
+    auto compressedSize = static_cast<uLongf>(compressed.size());
+
+    compress2(compressed.data(),
+              &compressedSize,
+              reinterpret_cast<const Bytef*>(rows.data()),
+              rows.size(),
+              Z_DEFAULT_COMPRESSION);
+
+    std::string header;
+    appendBigEndian32(header, width);
+    appendBigEndian32(header, height);
+    header += std::string{"\x08\x02\x00\x00\x00", 5};
+
+    std::string data{"\x89PNG\r\n\x1A\n"};
+    appendPngChunk(data, "IHDR", header);
+    appendPngChunk(data,
+                   "IDAT",
+                   std::string(compressed.begin(),
+                               compressed.begin() + compressedSize));
+    appendPngChunk(data, "IEND", "");
+
+    return data;
+}
+
+#endif
+
+//-------------------------------------------------------------------------
+
+int
+main(
+    int argc,
+    char *argv[])
+{
+    std::string device{"mem:800x480"};
+    int iterations{100};
+
+    static const char* sopts = "d:hi:";
+    static struct option lopts[] = 
+    {
+        { "device", required_argument, nullptr, 'd' },
+        { "help", no_argument, nullptr, 'h' },
+        { "iterations", required_argument, nullptr, 'i' },
+        { nullptr, no_argument, nullptr, 0 }
+    };
+
+    int opt = 0;
+
+    while ((opt = ::getopt_long(argc, argv, sopts, lopts, nullptr)) != -1)
+    {
+        switch (opt)
+        {
+        case 'd':
+
+            device = optarg;
+
+            break;
+
+        case 'h':
+
+            printUsage(std::cout, argv[0]);
+            ::exit(EXIT_SUCCESS);
+
+            break;
+
+        case 'i':
+
+            iterations = std::max(std::stoi(optarg), 1);
+
+            break;
+
+        default:
+
+            printUsage(std::cerr, argv[0]);
+            ::exit(EXIT_FAILURE);
+
+            break;
+        }
+    }
+
+    //---------------------------------------------------------------------
+
+    try
+    {
+        FrameBuffer565 fb{device};
+        fb.clear();
+
+        Image565 image{480, 320};
+
+        for (int j = 0 ; j < image.getHeight() ; ++j)
+        {
+            for (int i = 0 ; i < image.getWidth() ; ++i)
+            {
+                image.setPixelRGB(Image565Point(i, j),
+                                  RGB565(i, j, i ^ j));
+            }
+        }
+
+        //-----------------------------------------------------------------
+
+        const FB565Point origin{0, 0};
+        const int32_t width = fb.getWidth();
+        const int32_t height = fb.getHeight();
+        const int64_t fullScreen = static_cast<int64_t>(width) * height;
+        const int64_t quarterScreen = fullScreen / 4;
+
+        benchmark("putImage 480x320",
+                  iterations,
+                  static_cast<int64_t>(image.getWidth()) * image.getHeight(),
+                  [&] { fb.putImage(origin, image); });
+
+        // A width that leaves packed rows unaligned.
+
+        const Image565Rectangle narrow{0, 0, 470, 320};
+        Image565 packedImage{narrow.width(), narrow.height()};
+        Image565 alignedImage{narrow.width(),
+                              narrow.height(),
+                              Image565::Layout::ALIGNED};
+
+        blit(image, narrow, packedImage, Image565Point(0, 0));
+        blit(image, narrow, alignedImage, Image565Point(0, 0));
+
+        benchmark("putImage 470x320 (packed rows)",
+                  iterations,
+                  static_cast<int64_t>(narrow.width()) * narrow.height(),
+                  [&] { fb.putImage(origin, packedImage); });
+
+        benchmark("putImage 470x320 (aligned rows)",
+                  iterations,
+                  static_cast<int64_t>(narrow.width()) * narrow.height(),
+                  [&] { fb.putImage(origin, alignedImage); });
+
+        benchmark("putImage scaled nearest (full screen)",
+                  iterations,
+                  fullScreen,
+                  [&]
+                  {
+                      fb.putImage(origin,
+                                  image,
+                                  width,
+                                  height,
+                                  ScaleFilter::NEAREST);
+                  });
+
+        benchmark("putImage scaled bilinear (full screen)",
+                  iterations,
+                  fullScreen,
+                  [&]
+                  {
+                      fb.putImage(origin,
+                                  image,
+                                  width,
+                                  height,
+                                  ScaleFilter::BILINEAR);
+                  });
+
+        benchmark("putImage scaled nearest (quarter)",
+                  iterations,
+                  quarterScreen,
+                  [&]
+                  {
+                      fb.putImage(origin,
+                                  image,
+                                  width / 2,
+                                  height / 2,
+                                  ScaleFilter::NEAREST);
+                  });
+
+        benchmark("putImage scaled bilinear (quarter)",
+                  iterations,
+                  quarterScreen,
+                  [&]
+                  {
+                      fb.putImage(origin,
+                                  image,
+                                  width / 2,
+                                  height / 2,
+                                  ScaleFilter::BILINEAR);
+                  });
+
+        //-----------------------------------------------------------------
+
+        Image565Alpha overlay{image, 0x80};
+
+        benchmark("blendImage translucent 480x320",
+                  iterations,
+                  static_cast<int64_t>(image.getWidth()) * image.getHeight(),
+                  [&] { fb.blendImage(origin, overlay); });
+
+        for (int j = 0 ; j < overlay.getHeight() ; ++j)
+        {
+            for (int i = 0 ; i < overlay.getWidth() ; ++i)
+            {
+                uint8_t alpha = ((i / 32) % 2) ? 0xFF : ((j % 2) ? 0 : 0x40);
+                overlay.setAlpha(Image565Point(i, j), alpha);
+            }
+        }
+
+        benchmark("blendImage mixed 480x320",
+                  iterations,
+                  static_cast<int64_t>(image.getWidth()) * image.getHeight(),
+                  [&] { fb.blendImage(origin, overlay); });
+
+        Image565 target{480, 320};
+
+        benchmark("blendImage into Image565 480x320",
+                  iterations,
+                  static_cast<int64_t>(image.getWidth()) * image.getHeight(),
+                  [&] { blendImage(target, Image565Point(0, 0), overlay); });
+
+        //-----------------------------------------------------------------
+
+        Image565 icon{image};
+
+        for (int j = 0 ; j < icon.getHeight() ; ++j)
+        {
+            for (int i = 0 ; i < icon.getWidth() ; ++i)
+            {
+                if (((i / 16) + (j / 16)) % 2)
+                {
+                    icon.setPixel(Image565Point(i, j), 0);
+                }
+            }
+        }
+
+        Sprite565 sprite{icon, 0};
+
+        benchmark("putSprite 480x320 (checkerboard key)",
+                  iterations,
+                  static_cast<int64_t>(image.getWidth()) * image.getHeight(),
+                  [&] { fb.putSprite(origin, sprite); });
+
+        Compositor compositor;
+        compositor.addLayer(image, Image565Point(0, 0));
+        compositor.addLayer(overlay, Image565Point(0, 0));
+        compositor.addLayer(sprite, Image565Point(0, 0));
+
+        benchmark("Compositor::compose 3 layers 480x320",
+                  iterations,
+                  static_cast<int64_t>(image.getWidth()) * image.getHeight(),
+                  [&] { compositor.compose(target); });
+
+        //-----------------------------------------------------------------
+
+        const int64_t imagePixels =
+            static_cast<int64_t>(image.getWidth()) * image.getHeight();
+
+        benchmark("setPixel 480x320",
+                  iterations,
+                  imagePixels,
+                  [&]
+                  {
+                      for (int16_t j = 0 ; j < image.getHeight() ; ++j)
+                      {
+                          for (int16_t i = 0 ; i < image.getWidth() ; ++i)
+                          {
+                              image.setPixel(Image565Point(i, j), 0x1234);
+                          }
+                      }
+                  });
+
+        benchmark("boxFilled 480x320",
+                  iterations,
+                  imagePixels,
+                  [&]
+                  {
+                      boxFilled(image,
+                                Image565Point(0, 0),
+                                Image565Point(image.getWidth() - 1,
+                                              image.getHeight() - 1),
+                                0x1234);
+                  });
+
+        benchmark("verticalLine x 480",
+                  iterations,
+                  imagePixels,
+                  [&]
+                  {
+                      for (int16_t i = 0 ; i < image.getWidth() ; ++i)
+                      {
+                          verticalLine(image,
+                                       i,
+                                       0,
+                                       image.getHeight() - 1,
+                                       0x1234);
+                      }
+                  });
+
+        const std::string text(image.getWidth() / sc_fontWidth, 'W');
+
+        benchmark("drawString 480x320",
+                  iterations,
+                  imagePixels,
+                  [&]
+                  {
+                      for (int16_t j = 0 ;
+                           j < image.getHeight() ;
+                           j += sc_fontHeight)
+                      {
+                          drawString(Image565Point(0, j),
+                                     text,
+                                     RGB565(255, 255, 255),
+                                     image);
+                      }
+                  });
+
+        // Mostly background, with a line of text every few rows, like the
+        // legends and headings on a panel.
+
+        Image565 chrome{480, 320};
+        chrome.clear(0);
+
+        for (int16_t j = 0 ; j < chrome.getHeight() ; j += 4 * sc_fontHeight)
+        {
+            drawString(Image565Point(0, j),
+                       text,
+                       RGB565(255, 255, 255),
+                       chrome);
+        }
+
+        Rle565 encodedChrome{chrome};
+
+        benchmark("putImage chrome 480x320",
+                  iterations,
+                  imagePixels,
+                  [&] { fb.putImage(origin, chrome); });
+
+        benchmark("putImage chrome 480x320 (Rle565)",
+                  iterations,
+                  imagePixels,
+                  [&] { fb.putImage(origin, encodedChrome); });
+
+        //-----------------------------------------------------------------
+
+        // A smooth gradient with some fine detail, more like a photo or
+        // a rendered background than the flat colours above.
+
+        std::vector<uint8_t> photo;
+
+        for (int j = 0 ; j < 320 ; ++j)
+        {
+            for (int i = 0 ; i < 480 ; ++i)
+            {
+                photo.push_back((i * 255) / 479);
+                photo.push_back((j * 255) / 319);
+                photo.push_back(((i ^ j) & 7) + ((i + j) / 4));
+            }
+        }
+
+        auto decode = [&](const std::string& data, Dither dither)
+        {
+            StringBuffer buffer{data};
+            std::istream input{&buffer};
+            decodeImage(input, dither);
+        };
+
+        const auto ppm = encodePpm(480, 320, photo);
+        const auto qoi = encodeQoi(480, 320, photo);
+
+        benchmark("decodePpm 480x320",
+                  iterations,
+                  imagePixels,
+                  [&] { decode(ppm, Dither::NONE); });
+
+        benchmark("decodePpm 480x320 (ORDERED)",
+                  iterations,
+                  imagePixels,
+                  [&] { decode(ppm, Dither::ORDERED); });
+
+        benchmark("decodeQoi 480x320",
+                  iterations,
+                  imagePixels,
+                  [&] { decode(qoi, Dither::NONE); });
+
+#ifdef RASPIFB16_ZLIB
+        const auto png = encodePng(480, 320, photo);
+
+        benchmark("decodePng 480x320",
+                  iterations,
+                  imagePixels,
+                  [&] { decode(png, Dither::NONE); });
+#endif
+
+        // Opening a mapped raw .i565 file, against decoding the same image.
+
+        StringBuffer ppmBuffer{ppm};
+        std::istream ppmInput{&ppmBuffer};
+        const auto decoded = decodePpm(ppmInput);
+
+        char filename[] = "/tmp/raspifb16benchmarkXXXXXX";
+        close(mkstemp(filename));
+        MappedImage565::write(filename, decoded);
+
+        benchmark("MappedImage565 480x320 (open)",
+                  iterations,
+                  imagePixels,
+                  [&] { MappedImage565 mapped{filename}; });
+
+        {
+            MappedImage565 mapped{filename};
+
+            benchmark("putImage 480x320 (MappedImage565)",
+                      iterations,
+                      imagePixels,
+                      [&] { fb.putImage(origin, mapped); });
+        }
+
+        unlink(filename);
+
+        //-----------------------------------------------------------------
+
+        // Bulk conversion against converting one pixel at a time with
+        // RGB565, for each set of kernels this CPU supports.
+
+        std::vector<uint16_t> pixels(imagePixels);
+        std::vector<uint8_t> rgb888(imagePixels * 3);
+        std::vector<uint8_t> xrgb8888(imagePixels * 4);
+
+        for (size_t i = 0 ; i < pixels.size() ; ++i)
+        {
+            pixels[i] = i * 1777;
+        }
+
+        benchmark("RGB565 to RGB888 per pixel",
+                  iterations,
+                  imagePixels,
+                  [&]
+                  {
+                      for (size_t i = 0 ; i < pixels.size() ; ++i)
+                      {
+                          RGB565 rgb{pixels[i]};
+                          rgb888[i * 3] = rgb.getBlue();
+                          rgb888[(i * 3) + 1] = rgb.getGreen();
+                          rgb888[(i * 3) + 2] = rgb.getRed();
+                      }
+                  });
+
+        benchmark("RGB565 from RGB888 per pixel",
+                  iterations,
+                  imagePixels,
+                  [&]
+                  {
+                      for (size_t i = 0 ; i < pixels.size() ; ++i)
+                      {
+                          RGB565 rgb{rgb888[(i * 3) + 2],
+                                     rgb888[(i * 3) + 1],
+                                     rgb888[i * 3]};
+                          pixels[i] = rgb.get565();
+                      }
+                  });
+
+        const auto bestKernels = getConvertKernels();
+
+        for (auto kernels : { ConvertKernels::SCALAR,
+                              ConvertKernels::SSE2,
+                              ConvertKernels::AVX2,
+                              ConvertKernels::NEON })
+        {
+            if (setConvertKernels(kernels) == false)
+            {
+                continue;
+            }
+
+            const std::string name{convertKernelsName(kernels)};
+
+            benchmark("rgb565ToRgb888 (" + name + ")",
+                      iterations,
+                      imagePixels,
+                      [&]
+                      {
+                          rgb565ToRgb888(rgb888.data(),
+                                         pixels.data(),
+                                         pixels.size());
+                      });
+
+            benchmark("rgb888ToRgb565 (" + name + ")",
+                      iterations,
+                      imagePixels,
+                      [&]
+                      {
+                          rgb888ToRgb565(pixels.data(),
+                                         rgb888.data(),
+                                         pixels.size());
+                      });
+
+            benchmark("rgb565ToXrgb8888 (" + name + ")",
+                      iterations,
+                      imagePixels,
+                      [&]
+                      {
+                          rgb565ToXrgb8888(xrgb8888.data(),
+                                           pixels.data(),
+                                           pixels.size());
+                      });
+
+            benchmark("xrgb8888ToRgb565 (" + name + ")",
+                      iterations,
+                      imagePixels,
+                      [&]
+                      {
+                          xrgb8888ToRgb565(pixels.data(),
+                                           xrgb8888.data(),
+                                           pixels.size());
+                      });
+        }
+
+        setConvertKernels(bestKernels);
+
+        //-----------------------------------------------------------------
+
+        benchmark("Image565::scroll 480x320",
+                  iterations,
+                  imagePixels,
+                  [&] { image.scroll(-1, 0, 0x1234); });
+
+        const FB565Rectangle screen{0, 0, fb.getWidth(), fb.getHeight()};
+
+        benchmark("FrameBuffer565::scroll full screen",
+                  iterations,
+                  static_cast<int64_t>(fb.getWidth()) * fb.getHeight(),
+                  [&] { fb.scroll(screen, -1, 0); });
+
+        fb.clear();
+    }
+    catch (std::exception& error)
+    {
+        std::cerr << "Error: " << error.what() << "\n";
+        exit(EXIT_FAILURE);
+    }
+
+    return 0;
+}
@@ -25,16 +25,36 @@
 //
 //-------------------------------------------------------------------------
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
 #include <system_error>
 
+#include <getopt.h>
 #include <unistd.h>
 
+#include "blit565.h"
+#include "callStatistics.h"
+#include "compositor.h"
+#include "convert565.h"
+#include "frameCapture.h"
 #include "framebuffer565.h"
 #include "image565.h"
+#include "image565Alpha.h"
 #include "image565Font.h"
 #include "image565Graphics.h"
+#include "image565View.h"
+#include "imageDecoder.h"
+#include "imagePool.h"
+#include "mappedImage565.h"
 #include "point.h"
+#include "presenter.h"
+#include "rle565.h"
+#include "sprite565.h"
 
 //-------------------------------------------------------------------------
 
@@ -54,18 +74,87 @@ using namespace raspifb16;
 
 //-------------------------------------------------------------------------
 
+void
+printUsage(
+    std::ostream& os,
+    const std::string& name)
+{
+    os << "\n";
+    os << "Usage: " << name << " <options>\n";
+    os << "\n";
+    os << "    --device,-d - framebuffer device to use";
+    os << " (default is /dev/fb1, or mem:<width>x<height>)\n";
+    os << "    --help,-h - print usage and exit\n";
+    os << "    --wait,-w <seconds> - time to leave the result on screen";
+    os << " (default is 10)\n";
+    os << "\n";
+}
+
+//-------------------------------------------------------------------------
+
 int
-main()
+main(
+    int argc,
+    char *argv[])
 {
+    std::string device{"/dev/fb1"};
+    unsigned int wait{10};
+
+    static const char* sopts = "d:hw:";
+    static struct option lopts[] = 
+    {
+        { "device", required_argument, nullptr, 'd' },
+        { "help", no_argument, nullptr, 'h' },
+        { "wait", required_argument, nullptr, 'w' },
+        { nullptr, no_argument, nullptr, 0 }
+    };
+
+    int opt = 0;
+
+    while ((opt = ::getopt_long(argc, argv, sopts, lopts, nullptr)) != -1)
+    {
+        switch (opt)
+        {
+        case 'd':
+
+            device = optarg;
+
+            break;
+
+        case 'h':
+
+            printUsage(std::cout, argv[0]);
+            ::exit(EXIT_SUCCESS);
+
+            break;
+
+        case 'w':
+
+            wait = std::stoul(optarg);
+
+            break;
+
+        default:
+
+            printUsage(std::cerr, argv[0]);
+            ::exit(EXIT_FAILURE);
+
+            break;
+        }
+    }
+
+    //---------------------------------------------------------------------
+
     try
     {
-        FrameBuffer565 fb{"/dev/fb1"};
+        FrameBuffer565 fb{device};
         fb.clear();
 
         //-----------------------------------------------------------------
 
         RGB565 red{255, 0, 0};
         RGB565 green{0, 255, 0};
+        RGB565 white{255, 255, 255};
 
         //-----------------------------------------------------------------
 
@@ -95,10 +184,545 @@ main()
         TEST((rgb.first == true), "FrameBuffer565::getPixelRGB()");
         TEST((rgb.second == green), "FrameBuffer565::getPixelRGB()");
 
+        fb.putImage(imageLocation, image, Rotation::ROTATE_90);
+
+        rgb = fb.getPixelRGB(imageLocation);
+
+        TEST((rgb.second == red), "FrameBuffer565::putImage(ROTATE_90)");
+
+        rgb = fb.getPixelRGB(FB565Point{imageLocation.x() + 47,
+                                        imageLocation.y()});
+
+        TEST((rgb.second == green), "FrameBuffer565::putImage(ROTATE_90)");
+
+        Image565 blackWhite{2, 1};
+        blackWhite.setPixelRGB(Image565Point(0, 0), RGB565{0, 0, 0});
+        blackWhite.setPixelRGB(Image565Point(1, 0), white);
+
+        fb.putImage(FB565Point{0, 0}, blackWhite, 4, 2, ScaleFilter::NEAREST);
+
+        TEST((fb.getPixelRGB(FB565Point{1, 1}).second == RGB565(0, 0, 0)),
+             "FrameBuffer565::putImage(NEAREST)");
+        TEST((fb.getPixelRGB(FB565Point{2, 1}).second == white),
+             "FrameBuffer565::putImage(NEAREST)");
+
+        fb.putImage(FB565Point{0, 0}, blackWhite, 4, 2, ScaleFilter::BILINEAR);
+
+        rgb = fb.getPixelRGB(FB565Point{1, 0});
+
+        TEST(((rgb.second.get565() != 0) && (rgb.second != white)),
+             "FrameBuffer565::putImage(BILINEAR)");
+        TEST((fb.getPixelRGB(FB565Point{3, 1}).second == white),
+             "FrameBuffer565::putImage(BILINEAR)");
+
+        //-----------------------------------------------------------------
+
+        Image565Alpha overlay{4, 1};
+        overlay.clear(white, 0);
+        overlay.setAlpha(Image565Point(1, 0), 0x80);
+        overlay.setAlpha(Image565Point(2, 0), 0xFF);
+
+        Image565 background{4, 1};
+        background.clear(red);
+
+        blendImage(background, Image565Point(0, 0), overlay);
+
+        TEST((background.getPixelRGB(Image565Point(0, 0)).second == red),
+             "blendImage()");
+        TEST((background.getPixelRGB(Image565Point(2, 0)).second == white),
+             "blendImage()");
+
+        rgb = background.getPixelRGB(Image565Point(1, 0));
+
+        TEST(((rgb.second != red) && (rgb.second != white)), "blendImage()");
+
+        fb.putImage(FB565Point{0, 0}, Image565{4, 1});
+        fb.blendImage(FB565Point{0, 0}, overlay);
+
+        TEST((fb.getPixel(FB565Point{0, 0}).second == 0),
+             "FrameBuffer565::blendImage()");
+        TEST((fb.getPixelRGB(FB565Point{2, 0}).second == white),
+             "FrameBuffer565::blendImage()");
+        TEST((fb.getPixel(FB565Point{1, 0}).second != 0),
+             "FrameBuffer565::blendImage()");
+
+        Image565 icon{3, 2};
+        icon.clear(red);
+        icon.setPixelRGB(Image565Point(1, 0), green);
+        icon.setPixelRGB(Image565Point(2, 1), green);
+
+        Sprite565 sprite{icon, red};
+
+        TEST((sprite.getSpans(0).second - sprite.getSpans(0).first == 1),
+             "Sprite565::getSpans()");
+
+        fb.putImage(FB565Point{0, 0}, Image565{3, 2});
+        fb.putSprite(FB565Point{-1, 0}, sprite);
+
+        TEST((fb.getPixelRGB(FB565Point{0, 0}).second == green),
+             "FrameBuffer565::putSprite()");
+        TEST((fb.getPixel(FB565Point{0, 1}).second == 0),
+             "FrameBuffer565::putSprite()");
+        TEST((fb.getPixelRGB(FB565Point{1, 1}).second == green),
+             "FrameBuffer565::putSprite()");
+
+        fb.flush();
+        fb.setPixelRGB(FB565Point{0, 0}, red);
+
+        TEST((fb.getDirtyPages() == 1), "FrameBuffer565::getDirtyPages()");
+        TEST((fb.flush(FB565Rectangle(0, fb.getHeight() - 8, 8, 8)) == 0),
+             "FrameBuffer565::flush(rectangle)");
+        TEST((fb.flush(FB565Rectangle(0, 0, 8, 8)) == 1),
+             "FrameBuffer565::flush(rectangle)");
+        TEST((fb.getDirtyPages() == 0), "FrameBuffer565::flush()");
+
+        // Only one column of the image is on screen.
+
+        TEST((fb.putImage(FB565Point{fb.getWidth() - 1, 0}, icon)),
+             "FrameBuffer565::putImage()");
+        TEST((fb.getPixelRGB(FB565Point{fb.getWidth() - 1, 0}).second == red),
+             "FrameBuffer565::putImage()");
+
+        Image565 strip{4, 2};
+        strip.clear(red);
+        strip.setPixelRGB(Image565Point(0, 0), green);
+
+        blit(strip, Image565Rectangle(0, 0, 3, 1), strip, Image565Point(1, 1));
+
+        TEST((strip.getPixelRGB(Image565Point(1, 1)).second == green),
+             "blit(Image565, Image565)");
+        TEST((strip.getPixelRGB(Image565Point(0, 1)).second == red),
+             "blit(Image565, Image565)");
+
+        // Down one row through a view of the same image.
+
+        Image565 column{1, 4};
+        column.clear(red);
+        column.setPixelRGB(Image565Point(0, 0), green);
+
+        blit(column,
+             Image565Rectangle(0, 0, 1, 3),
+             Image565View{column, Image565Rectangle(0, 1, 1, 3)},
+             Image565Point(0, 0));
+
+        TEST((column.getPixelRGB(Image565Point(0, 1)).second == green),
+             "blit(Image565, Image565View)");
+        TEST((column.getPixelRGB(Image565Point(0, 2)).second == red),
+             "blit(Image565, Image565View)");
+
+        blit(strip, Image565Rectangle(1, 1, 1, 1), fb, FB565Point{-1, 0});
+        blit(strip, Image565Rectangle(1, 1, 1, 1), fb, FB565Point{2, 3});
+
+        TEST((fb.getPixelRGB(FB565Point{2, 3}).second == green),
+             "blit(Image565, FrameBuffer565)");
+
+        blit(fb, FB565Rectangle(2, 3, 1, 1), fb, FB565Point{3, 3});
+        blit(fb, FB565Rectangle(2, 2, 2, 2), strip, Image565Point(2, 0));
+
+        TEST((strip.getPixelRGB(Image565Point(3, 1)).second == green),
+             "blit(FrameBuffer565, Image565)");
+
+        Image565 aligned{5, 3, Image565::Layout::ALIGNED};
+        aligned.clear(red);
+
+        TEST(((aligned.getStride() * sizeof(uint16_t)) %
+              Image565::sc_rowAlignment == 0),
+             "Image565::getStride()");
+        TEST(((reinterpret_cast<uintptr_t>(aligned.getRow(1)) %
+               Image565::sc_rowAlignment) == 0),
+             "Image565::getRow()");
+
+        blit(strip,
+             Image565Rectangle(0, 0, 4, 2),
+             aligned,
+             Image565Point(1, 1));
+
+        TEST((aligned.getPixelRGB(Image565Point(1, 1)).second == green),
+             "blit(Image565, Image565)");
+        TEST((aligned.getPixelRGB(Image565Point(0, 2)).second == red),
+             "blit(Image565, Image565)");
+
+        strip.scroll(1, 1, white.get565());
+
+        TEST((strip.getPixelRGB(Image565Point(1, 1)).second == green),
+             "Image565::scroll()");
+        TEST((strip.getPixelRGB(Image565Point(0, 1)).second == white),
+             "Image565::scroll()");
+        TEST((strip.getPixelRGB(Image565Point(0, 0)).second == white),
+             "Image565::scroll()");
+
+        auto drawStatistics = fb.getDrawStatistics();
+
+        TEST(((drawStatistics.m_putImage.m_calls > 0) ==
+              callStatisticsEnabled),
+             "FrameBuffer565::getDrawStatistics()");
+
+        CallStatistics calls{};
+        calls.m_calls = 4;
+        calls.m_histogram[3] = 3;
+        calls.m_histogram[10] = 1;
+
+        TEST((calls.percentile(0.5) == std::chrono::nanoseconds(16)),
+             "CallStatistics::percentile()");
+        TEST((calls.percentile(1.0) == std::chrono::nanoseconds(2048)),
+             "CallStatistics::percentile()");
+
+        fb.scroll(FB565Rectangle(0, 0, 8, 8), 2, 1, white.get565());
+
+        TEST((fb.getPixelRGB(FB565Point{5, 4}).second == green),
+             "FrameBuffer565::scroll()");
+        TEST((fb.getPixelRGB(FB565Point{1, 4}).second == white),
+             "FrameBuffer565::scroll()");
+        TEST((fb.getPixelRGB(FB565Point{5, 0}).second == white),
+             "FrameBuffer565::scroll()");
+
+        //-----------------------------------------------------------------
+
+        Image565 backing{20, 10};
+        backing.clear(red);
+
+        Image565View window{backing, Image565Rectangle(4, 2, 8, 4)};
+        boxFilled(window, Image565Point(-5, -5), Image565Point(50, 50), green);
+
+        TEST((backing.getPixelRGB(Image565Point(4, 2)).second == green),
+             "Image565View");
+        TEST((backing.getPixelRGB(Image565Point(11, 5)).second == green),
+             "Image565View");
+        TEST((backing.getPixelRGB(Image565Point(12, 5)).second == red),
+             "Image565View");
+        TEST((backing.getPixelRGB(Image565Point(4, 6)).second == red),
+             "Image565View");
+
+        auto screen = fb.getView(FB565Rectangle(10, 10, 4, 4));
+
+        if (fb.getBytesPerPixel() == 2)
+        {
+            horizontalLine(screen, 0, 10, 1, white);
+
+            TEST((fb.getPixelRGB(FB565Point{13, 11}).second == white),
+                 "FrameBuffer565::getView()");
+            TEST((fb.getPixelRGB(FB565Point{14, 11}).second != white),
+                 "FrameBuffer565::getView()");
+
+            // Once flushed, the pages are only dirty again for a new view.
+
+            fb.flush();
+            screen = fb.getView(FB565Rectangle(10, 10, 4, 4));
+            horizontalLine(screen, 0, 10, 2, white);
+
+            TEST((fb.getDirtyPages() > 0), "FrameBuffer565::getView()");
+        }
+        else
+        {
+            TEST((screen.empty()), "FrameBuffer565::getView()");
+        }
+
+        //-----------------------------------------------------------------
+
+        Image565 backdrop{16, 16};
+        backdrop.clear(red);
+
+        Image565 hidden{4, 4};
+        hidden.clear(white);
+
+        Image565Alpha shade{4, 4};
+        shade.clear(white, 0xFF);
+        shade.setAlpha(Image565Point(3, 3), 0);
+
+        Compositor compositor;
+        compositor.addLayer(backdrop, Image565Point(0, 0));
+        auto hiddenLayer = compositor.addLayer(hidden, Image565Point(0, 0));
+        compositor.addLayer(shade, Image565Point(6, 6));
+        compositor.setVisible(hiddenLayer, false);
+
+        Image565 composed{12, 12};
+        composed.clear(green);
+        compositor.compose(composed, Image565Rectangle(0, 0, 12, 10));
+
+        TEST((composed.getPixelRGB(Image565Point(0, 0)).second == red),
+             "Compositor::compose()");
+        TEST((composed.getPixelRGB(Image565Point(6, 6)).second == white),
+             "Compositor::compose()");
+        TEST((composed.getPixelRGB(Image565Point(9, 9)).second == red),
+             "Compositor::compose()");
+        TEST((composed.getPixelRGB(Image565Point(0, 10)).second == green),
+             "Compositor::compose()");
+
+        Rle565 encoded{composed};
+
+        TEST((encoded.getEncodedSize() < 12 * 12 * sizeof(uint16_t)),
+             "Rle565::getEncodedSize()");
+        TEST((encoded.decode().getPixelRGB(Image565Point(6, 6)).second ==
+              white),
+             "Rle565::decode()");
+
+        fb.putImage(FB565Point{-6, 0}, encoded);
+
+        TEST((fb.getPixelRGB(FB565Point{0, 6}).second == white),
+             "FrameBuffer565::putImage(Rle565)");
+        TEST((fb.getPixelRGB(FB565Point{5, 11}).second == green),
+             "FrameBuffer565::putImage(Rle565)");
+
+        //-----------------------------------------------------------------
+
+        {
+            // Widening 565 and truncating it again gives back the same
+            // pixels, with every set of kernels this CPU supports.
+
+            const auto best = getConvertKernels();
+            uint16_t pixels[37];
+            uint16_t converted[37];
+            uint8_t rgb888[37 * 3];
+            uint8_t xrgb8888[37 * 4];
+
+            for (int i = 0 ; i < 37 ; ++i)
+            {
+                pixels[i] = i * 1777;
+            }
+
+            for (auto kernels : { ConvertKernels::SCALAR,
+                                  ConvertKernels::SSE2,
+                                  ConvertKernels::AVX2,
+                                  ConvertKernels::NEON })
+            {
+                if (setConvertKernels(kernels) == false)
+                {
+                    continue;
+                }
+
+                rgb565ToRgb888(rgb888, pixels, 37);
+                rgb888ToRgb565(converted, rgb888, 37);
+
+                TEST((std::equal(pixels, pixels + 37, converted)),
+                     "rgb888ToRgb565()");
+                TEST((rgb888[3 * 36 + 2] == RGB565(pixels[36]).getRed()),
+                     "rgb565ToRgb888()");
+
+                rgb565ToXrgb8888(xrgb8888, pixels, 37, 0xFF);
+                xrgb8888ToRgb565(converted, xrgb8888, 37);
+
+                TEST((std::equal(pixels, pixels + 37, converted)),
+                     "xrgb8888ToRgb565()");
+                TEST((xrgb8888[4 * 36 + 3] == 0xFF), "rgb565ToXrgb8888()");
+            }
+
+            setConvertKernels(best);
+        }
+
+        //-----------------------------------------------------------------
+
+        ImagePool pool;
+
+        auto pooled = pool.acquire(100, 50);
+        pooled.clear(red);
+        pool.release(std::move(pooled));
+
+        TEST((pooled.getWidth() == 0), "Image565(Image565&&)");
+
+        {
+            // An image released into a full size class is still taken.
+
+            ImagePool single{1};
+            single.release(Image565{100, 50});
+
+            Image565 spare{100, 50};
+            single.release(std::move(spare));
+
+            TEST((spare.getCapacity() == 0), "ImagePool::release()");
+            TEST((single.getStatistics().m_discarded == 1),
+                 "ImagePool::release()");
+        }
+
+        // Once the pool has a buffer of the right size class, drawing a
+        // frame into a pooled image should not need a new pixel buffer.
+
+        auto buffers = pixelBufferAllocationCount().load();
+
+        for (int frame = 0 ; frame < 3 ; ++frame)
+        {
+            auto overlay = pool.acquire(90, 60, Image565::Layout::ALIGNED);
+            overlay.clear(red);
+            drawString(FontPoint{0, 0}, "frame", white, overlay);
+            fb.putImage(FB565Point{0, 0}, overlay);
+            pool.release(std::move(overlay));
+        }
+
+        TEST((pixelBufferAllocationCount().load() == buffers),
+             "ImagePool::acquire()");
+        TEST((pool.getStatistics().m_reused == 3),
+             "ImagePool::getStatistics()");
+
+        //-----------------------------------------------------------------
+
+        {
+            const std::string header{"P6\n# red, green\n2 1\n255\n"};
+            const std::string pixels{"\xFF\0\0\0\xFF\0", 6};
+            std::istringstream ppm{header + pixels};
+            auto decoded = decodeImage(ppm);
+
+            TEST((decoded.getWidth() == 2), "decodePpm()");
+            TEST((decoded.getPixelRGB(Image565Point(1, 0)).second == green),
+                 "decodePpm()");
+
+            // Red, a run of one more, green, then red again from the index.
+
+            std::istringstream qoi{std::string{"qoif\0\0\0\x02\0\0\0\x02\x03\0"
+                                               "\xFE\xFF\0\0\xC0"
+                                               "\xFE\0\xFF\0\x32"
+                                               "\0\0\0\0\0\0\0\x01",
+                                               32}};
+            decoded = decodeImage(qoi);
+
+            TEST((decoded.getPixelRGB(Image565Point(1, 0)).second == red),
+                 "decodeQoi()");
+            TEST((decoded.getPixelRGB(Image565Point(0, 1)).second == green),
+                 "decodeQoi()");
+            TEST((decoded.getPixelRGB(Image565Point(1, 1)).second == red),
+                 "decodeQoi()");
+
+            // A flat dark red, half way to the first step of the 5 bit
+            // red channel, is black without dithering and half lit with
+            // it.
+
+            std::string darkRed{"P6 4 4 255\n"};
+
+            for (int i = 0 ; i < 16 ; ++i)
+            {
+                darkRed += std::string{"\x04\0\0", 3};
+            }
+
+            std::istringstream dark{darkRed};
+            decoded = decodePpm(dark, Dither::ORDERED);
+
+            int lit{0};
+
+            for (int16_t y = 0 ; y < 4 ; ++y)
+            {
+                for (int16_t x = 0 ; x < 4 ; ++x)
+                {
+                    lit += (decoded.getPixel(Image565Point(x, y)).second != 0);
+                }
+            }
+
+            TEST((lit == 8), "decodePpm(Dither::ORDERED)");
+
+#ifdef RASPIFB16_ZLIB
+            // Red and green, then blue and white filtered from the row
+            // above.
+
+            std::istringstream png{std::string{
+                "\x89\x50\x4E\x47\x0D\x0A\x1A\x0A\x00\x00\x00\x0D"
+                "\x49\x48\x44\x52\x00\x00\x00\x02\x00\x00\x00\x02"
+                "\x08\x02\x00\x00\x00\xFD\xD4\x9A\x73\x00\x00\x00"
+                "\x16\x49\x44\x41\x54\x78\xDA\x63\xF8\xCF\xC0\xC0"
+                "\xF0\x9F\x81\x89\x91\xE1\xFF\x7F\x86\xFF\x00\x1E"
+                "\x04\x04\xFF\x4E\x50\x9E\xC7\x00\x00\x00\x00\x49"
+                "\x45\x4E\x44\xAE\x42\x60\x82",
+                79}};
+            decoded = decodeImage(png);
+
+            TEST((decoded.getPixelRGB(Image565Point(0, 1)).second ==
+                  RGB565(0, 0, 255)),
+                 "decodePng()");
+            TEST((decoded.getPixelRGB(Image565Point(1, 1)).second == white),
+                 "decodePng()");
+
+            // Huge header and palette lengths are refused before any
+            // buffer is allocated for them.
+
+            const std::string signature{"\x89\x50\x4E\x47\x0D\x0A\x1A\x0A"};
+            const std::string pngHeader{
+                "\x00\x00\x00\x0D\x49\x48\x44\x52\x00\x00\x00\x02"
+                "\x00\x00\x00\x02\x08\x02\x00\x00\x00\xFD\xD4\x9A"
+                "\x73",
+                25};
+
+            auto pngError = [](const std::string& bad)
+            {
+                try
+                {
+                    std::istringstream badPng{bad};
+                    decodePng(badPng);
+                }
+                catch (std::runtime_error& error)
+                {
+                    return std::string{error.what()};
+                }
+
+                return std::string{};
+            };
+
+            TEST((pngError(signature + "\x7F\xFF\xFF\xF0IHDR") ==
+                  "bad PNG header"),
+                 "decodePng()");
+            TEST((pngError(signature + pngHeader + "\x7F\xFF\xFF\xFEPLTE") ==
+                  "bad PNG palette"),
+                 "decodePng()");
+#endif
+        }
+
+        //-----------------------------------------------------------------
+
+        for (auto encoding : { MappedImage565::Encoding::RAW,
+                               MappedImage565::Encoding::RLE })
+        {
+            char filename[] = "/tmp/raspifb16testXXXXXX";
+            close(mkstemp(filename));
+
+            MappedImage565::write(filename, composed, encoding);
+            MappedImage565 mapped{filename};
+            unlink(filename);
+
+            TEST((mapped.getEncoding() == encoding),
+                 "MappedImage565::getEncoding()");
+            TEST((mapped.getWidth() == composed.getWidth()),
+                 "MappedImage565::getWidth()");
+
+            fb.clear();
+            fb.putImage(FB565Point{0, 0}, mapped);
+
+            TEST((fb.getPixelRGB(FB565Point{6, 6}).second == white),
+                 "FrameBuffer565::putImage(MappedImage565)");
+            TEST((fb.getPixelRGB(FB565Point{0, 11}).second == green),
+                 "FrameBuffer565::putImage(MappedImage565)");
+        }
+
+        {
+            // A stride large enough to wrap the size check around in 32
+            // bits must still be refused.
+
+            char filename[] = "/tmp/raspifb16testXXXXXX";
+            close(mkstemp(filename));
+
+            MappedImage565::write(filename,
+                                  composed,
+                                  MappedImage565::Encoding::RAW);
+
+            const unsigned char stride[] = { 0x00, 0x00, 0x00, 0x80 };
+            auto file = std::fopen(filename, "r+b");
+            std::fseek(file, 12, SEEK_SET);
+            std::fwrite(stride, sizeof(stride), 1, file);
+            std::fclose(file);
+
+            bool refused = false;
+
+            try
+            {
+                MappedImage565 mapped{filename};
+            }
+            catch (std::runtime_error&)
+            {
+                refused = true;
+            }
+
+            unlink(filename);
+
+            TEST((refused), "MappedImage565 stride check");
+        }
+
         //-----------------------------------------------------------------
 
         RGB565 darkBlue{0, 0, 63};
-        RGB565 white{255, 255, 255};
 
         Image565 textImage(168, 16);
         textImage.clear(darkBlue);
@@ -119,7 +743,207 @@ main()
 
         //-----------------------------------------------------------------
 
-        sleep(10);
+        {
+            FrameBuffer565 mirror{"mem:64x64x32"};
+
+            Presenter presenter{fb};
+            presenter.addTarget(mirror);
+
+            Image565 cornerImage{16, 16};
+            cornerImage.clear(red);
+
+            presenter.submit(FB565Point{0, 0}, cornerImage);
+
+            cornerImage.clear(green);
+
+            presenter.submit(FB565Point{0, 0}, cornerImage);
+            presenter.present();
+            presenter.waitForIdle();
+
+            auto statistics = presenter.getStatistics();
+
+            TEST((statistics.m_submitted == 2), "Presenter::submit()");
+            TEST(((statistics.m_written + statistics.m_stale) == 2),
+                 "Presenter::submit()");
+            TEST((statistics.m_queueDepth == 0), "Presenter::waitForIdle()");
+
+            rgb = fb.getPixelRGB(FB565Point{15, 15});
+
+            TEST((rgb.second == green), "Presenter::present()");
+
+            rgb = mirror.getPixelRGB(FB565Point{15, 15});
+
+            TEST((rgb.second == green), "Presenter::addTarget()");
+        }
+
+        {
+            // An image is only stale if replaced within the same frame. A
+            // frame waiting for its present() must not drop the image
+            // before it, so each image here has to be written. The first
+            // few keep the presenter busy while the rest are queued.
+
+            FrameBuffer565 busy{"mem:800x480x24"};
+            Presenter presenter{busy};
+
+            Image565 screenImage{800, 480};
+            screenImage.clear(red);
+
+            for (int32_t x = 0 ; x < 4 ; ++x)
+            {
+                presenter.submit(FB565Point{x, 0}, screenImage);
+            }
+
+            Image565 cornerImage{16, 16};
+            cornerImage.clear(red);
+            presenter.submit(FB565Point{0, 0}, cornerImage);
+            presenter.present();
+
+            cornerImage.clear(green);
+            presenter.submit(FB565Point{0, 0}, cornerImage);
+            presenter.waitForIdle();
+
+            auto statistics = presenter.getStatistics();
+
+            TEST((statistics.m_stale == 0), "Presenter::present()");
+            TEST((statistics.m_written == 6), "Presenter::present()");
+        }
+
+        //-----------------------------------------------------------------
+
+        {
+            auto image = fb.snapshot();
+
+            TEST((image.getPixelRGB(Image565Point(15, 15)).second == green),
+                 "FrameBuffer565::snapshot()");
+
+            FILE* file = tmpfile();
+
+            {
+                FrameCapture capture{fb, fileno(file), true};
+                capture.capture();
+                capture.capture();
+            }
+
+            TEST((ftell(file) == image.getWidth() * image.getHeight() * 2),
+                 "FrameCapture::capture()");
+
+            fclose(file);
+        }
+
+        //-----------------------------------------------------------------
+
+        {
+            // Nothing drawn to a double buffered surface, not even a
+            // clear, is visible until present() copies the back buffer.
+
+            FrameBuffer565 doubled{"mem:64x32",
+                                   FrameBuffer565::Buffering::DOUBLE};
+            doubled.clear(red);
+            doubled.setPixelRGB(FB565Point{1, 1}, green);
+
+            auto shown = doubled.snapshot();
+
+            TEST((doubled.getPixelRGB(FB565Point{5, 5}).second == red),
+                 "FrameBuffer565::clear(DOUBLE)");
+            TEST((shown.getPixel(Image565Point(5, 5)).second == 0),
+                 "FrameBuffer565::clear(DOUBLE)");
+            TEST((shown.getPixel(Image565Point(1, 1)).second == 0),
+                 "FrameBuffer565::setPixel(DOUBLE)");
+
+            doubled.present();
+            shown = doubled.snapshot();
+
+            TEST((shown.getPixelRGB(Image565Point(5, 5)).second == red),
+                 "FrameBuffer565::present(DOUBLE)");
+            TEST((shown.getPixelRGB(Image565Point(1, 1)).second == green),
+                 "FrameBuffer565::present(DOUBLE)");
+        }
+
+        //-----------------------------------------------------------------
+
+        {
+            // With the shadow, drawing what is already there writes
+            // nothing, and only the pixels that change are written.
+
+            FrameBuffer565 shadowed{"mem:32x16"};
+            shadowed.setShadowEnabled(true);
+
+            shadowed.clear(red);
+
+            TEST((shadowed.getBytesWritten() == 32 * 16 * 2),
+                 "FrameBuffer565::setShadowEnabled()");
+
+            shadowed.clear(red);
+
+            TEST((shadowed.getBytesWritten() == 0),
+                 "FrameBuffer565::setShadowEnabled()");
+
+            Image565 tile{8, 4};
+            tile.clear(red);
+            shadowed.putImage(FB565Point{4, 4}, tile);
+
+            TEST((shadowed.getBytesWritten() == 0),
+                 "FrameBuffer565::setShadowEnabled()");
+
+            tile.setPixelRGB(Image565Point(2, 1), green);
+            shadowed.putImage(FB565Point{4, 4}, tile);
+
+            TEST((shadowed.getBytesWritten() == 2),
+                 "FrameBuffer565::setShadowEnabled()");
+            TEST((shadowed.snapshot().getPixelRGB(Image565Point(6, 5)).second
+                  == green),
+                 "FrameBuffer565::setShadowEnabled()");
+        }
+
+        //-----------------------------------------------------------------
+
+        {
+            // A memory surface has no vertical blank, so with vsync each
+            // present() waits for the start of the next frame period.
+
+            FrameBuffer565 paced{"mem:32x16",
+                                 FrameBuffer565::Buffering::DOUBLE};
+            paced.setVsyncEnabled(true);
+
+            auto begin = std::chrono::steady_clock::now();
+
+            for (int frame = 0 ; frame < 3 ; ++frame)
+            {
+                paced.present();
+            }
+
+            auto elapsed = std::chrono::steady_clock::now() - begin;
+            const auto& statistics = paced.getPresentStatistics();
+
+            TEST((elapsed >= 2 * paced.getFramePeriod()),
+                 "FrameBuffer565::present()");
+            TEST((statistics.m_frames == 3),
+                 "FrameBuffer565::getPresentStatistics()");
+            TEST((statistics.m_minLatency <= statistics.m_lastLatency),
+                 "FrameBuffer565::getPresentStatistics()");
+            TEST((statistics.m_lastLatency <= statistics.m_maxLatency),
+                 "FrameBuffer565::getPresentStatistics()");
+            TEST((statistics.m_totalLatency >= statistics.m_maxLatency),
+                 "FrameBuffer565::getPresentStatistics()");
+            TEST((statistics.m_totalCopyTime < statistics.m_totalLatency),
+                 "FrameBuffer565::getPresentStatistics()");
+
+            // Without vsync present() does not wait, so no blank can be
+            // missed however long the copy takes.
+
+            auto missed = statistics.m_missedVsyncs;
+            paced.setVsyncEnabled(false);
+            paced.present();
+
+            TEST((statistics.m_frames == 4),
+                 "FrameBuffer565::getPresentStatistics()");
+            TEST((statistics.m_missedVsyncs == missed),
+                 "FrameBuffer565::getPresentStatistics()");
+        }
+
+        //-----------------------------------------------------------------
+
+        sleep(wait);
 
         fb.clear();
     }